@@ -0,0 +1,111 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    Bench.h
+  * @author  Naigon's Electronic Creations
+  * @brief   Bench
+  *          Tiny host microbenchmark harness. Each benchmark is a callable that
+  *          performs a known number of operations; it is repeated until a minimum
+  *          wall time has passed and the result is reported as ns/op and ops/sec.
+  *
+  *          Command line:
+  *            --csv           Print name,ns_per_op,ops_per_sec rows.
+  *            --quick         Shorter runs, for smoke testing.
+  *            --filter TEXT   Only run benchmarks whose name contains TEXT.
+  *************************************************************************************
+**/
+
+#ifndef __Bench_H_
+#define __Bench_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+class Bench
+{
+  public:
+    Bench(int argc, char **argv);
+
+    /**
+     * @brief   Time fn and print the result.
+     *
+     * @param   name
+     *          Benchmark name, ie "PixelColor::Morph/300".
+     *
+     * @param   opsPerCall
+     *          Number of operations one call to fn performs; ie the strip length.
+     *
+     * @param   fn
+     *          Callable to measure.
+     **/
+    template <typename Fn>
+    void Run(const std::string &name, uint64_t opsPerCall, Fn fn)
+    {
+        if (!IsSelected(name)) { return; }
+
+        typedef std::chrono::steady_clock Clock;
+
+        // Warm caches and branch predictors before timing.
+        fn();
+
+        uint64_t calls = 1;
+        double elapsedNs = 0.0;
+        while (true)
+        {
+            Clock::time_point start = Clock::now();
+            for (uint64_t i = 0; i < calls; i++) { fn(); }
+            elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start).count();
+
+            if (elapsedNs >= _minTimeNs || calls >= (1ull << 40)) { break; }
+            calls *= 2;
+        }
+
+        Report(name, elapsedNs / (double)(calls * opsPerCall));
+    }
+
+    /**
+     * @brief   Print the table header. Call once before the first Run.
+     **/
+    void PrintHeader() const;
+
+  private:
+    bool IsSelected(const std::string &name) const;
+    void Report(const std::string &name, double nsPerOp) const;
+
+    bool _csv;
+    double _minTimeNs;
+    std::string _filter;
+};
+
+/**
+ * @brief   Keep the compiler from discarding a value the benchmark computed.
+ **/
+template <typename T>
+inline void BenchKeep(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Per-module suites. Each lives in its own Bench<Module>.cpp.
+void RunAnimationStreamBenchmarks(Bench &bench);
+void RunButtonBenchmarks(Bench &bench);
+void RunCallbackBenchmarks(Bench &bench);
+void RunFixedFilterBenchmarks(Bench &bench);
+void RunIndexedPixelBufferBenchmarks(Bench &bench);
+void RunMathUtilsBenchmarks(Bench &bench);
+void RunObjectPoolBenchmarks(Bench &bench);
+void RunParallelRendererBenchmarks(Bench &bench);
+void RunParallelStripEncoderBenchmarks(Bench &bench);
+void RunPixelColorBenchmarks(Bench &bench);
+void RunPixelCompositorBenchmarks(Bench &bench);
+void RunStopwatchBenchmarks(Bench &bench);
+void RunTaskRunnerBenchmarks(Bench &bench);
+void RunTraceRecorderBenchmarks(Bench &bench);
+
+#endif //__Bench_H_
@@ -0,0 +1,68 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "AnimationEncoder.h"
+#include "Bench.h"
+
+namespace
+{
+    // An ignition-style sequence: the lit section grows from the hilt a few pixels per
+    // frame with a flickering tip, so only a handful of pixels change each frame.
+    AnimationEncoder MakeIgnition(uint16_t size)
+    {
+        const PixelColor palette[] = { PixelColor(0, 0, 0), PixelColor(0, 80, 255), PixelColor(200, 220, 255) };
+        const uint16_t frames = 120;
+        const uint16_t step = (uint16_t)(size / frames + 1);
+
+        AnimationEncoder encoder(size, 16, palette, 3);
+        std::vector<PixelColor> frame(size);
+
+        for (uint16_t f = 0; f < frames; f++)
+        {
+            uint16_t lit = (uint16_t)((uint32_t)f * step < size ? f * step : size);
+            for (uint16_t i = 0; i < size; i++)
+            {
+                frame[i] = i < lit ? palette[1] : palette[0];
+            }
+            for (uint16_t i = lit; i < lit + 3 && i < size; i++)
+            {
+                frame[i] = (f + i) & 1 ? palette[2] : PixelColor(255, 255, 255, (uint8_t)(f * 2));
+            }
+
+            encoder.AddFrame(&frame[0]);
+        }
+
+        return encoder;
+    }
+}
+
+void RunAnimationStreamBenchmarks(Bench &bench)
+{
+    const uint16_t stripSizes[] = { 144, 300, 1000 };
+
+    for (uint16_t size : stripSizes)
+    {
+        AnimationEncoder encoder = MakeIgnition(size);
+        const std::vector<uint8_t> &data = encoder.Data();
+
+        AnimationStream stream;
+        stream.Open(&data[0], (uint32_t)data.size());
+        std::vector<PixelColor> pixels(size);
+
+        // One op is one decoded frame.
+        std::string name = "AnimationStream::DecodeNextFrame/" + std::to_string(size)
+            + "/" + std::to_string(data.size()) + "B";
+        bench.Run(name, 1, [&]()
+        {
+            if (stream.DecodeNextFrame(&pixels[0], size) != 1)
+            {
+                stream.Rewind();
+                stream.DecodeNextFrame(&pixels[0], size);
+            }
+            BenchKeep(pixels[0]);
+        });
+    }
+}
@@ -0,0 +1,47 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Bench.h"
+#include "Button.h"
+
+void RunButtonBenchmarks(Bench &bench)
+{
+    const uint32_t pin = 10;
+    const uint16_t polls = 1000;
+
+    HostArduino::Reset();
+    HostArduino::SetPinLevel(pin, HIGH);
+
+    Button momentary(pin, ButtonType::Momentary, ButtonPolarity::ActiveLow, 500);
+    Button latching(pin, ButtonType::Latching, ButtonPolarity::ActiveLow, 500);
+
+    // Idle is the common case: the loop polls a button nobody is touching.
+    bench.Run("Button::DetermineButtonState/Momentary/idle", polls, [&]()
+    {
+        for (uint16_t i = 0; i < polls; i++) { BenchKeep(momentary.DetermineButtonState()); }
+    });
+
+    bench.Run("Button::DetermineButtonState/Latching/idle", polls, [&]()
+    {
+        for (uint16_t i = 0; i < polls; i++) { BenchKeep(latching.DetermineButtonState()); }
+    });
+
+    // Toggle the pin and advance time each poll so every branch gets exercised.
+    uint32_t now = 0;
+    bench.Run("Button::DetermineButtonState/Momentary/active", polls, [&]()
+    {
+        for (uint16_t i = 0; i < polls; i++)
+        {
+            now += 10;
+            HostArduino::SetMillis(now);
+            HostArduino::SetPinLevel(pin, (now / 330) & 1 ? LOW : HIGH);
+            BenchKeep(momentary.DetermineButtonState());
+        }
+    });
+
+    bench.Run("Button::IsPressed", polls, [&]()
+    {
+        for (uint16_t i = 0; i < polls; i++) { BenchKeep(momentary.IsPressed()); }
+    });
+}
@@ -0,0 +1,54 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Bench.h"
+#include "CallbackHandler.h"
+#include "EventDispatcher.h"
+
+namespace
+{
+    volatile uint32_t observed = 0;
+
+    void Observer(void *arg)
+    {
+        observed += arg != nullptr ? *(uint8_t *)arg : 1;
+    }
+}
+
+void RunCallbackBenchmarks(Bench &bench)
+{
+    const uint16_t fires = 1000;
+
+    CallbackHandler handler;
+    handler.RegisterCallback(Observer);
+
+    uint8_t payload = 1;
+    bench.Run("CallbackHandler::FireCallback", fires, [&]()
+    {
+        for (uint16_t i = 0; i < fires; i++) { handler.FireCallback(&payload); }
+    });
+
+    StaticEventDispatcher<EventDispatcher_MaxEvents> dispatcher;
+    for (uint8_t i = 0; i < EventDispatcher_MaxEvents; i++)
+    {
+        dispatcher.RegisterEventCallback(i, Observer, (EventPriority)(i % EVENT_PRIORITY_Count));
+    }
+
+    // A burst of posts to a few noisy events, dispatched once as a frame would.
+    bench.Run("EventDispatcher::Post", fires, [&]()
+    {
+        for (uint16_t i = 0; i < fires; i++)
+        {
+            uint8_t value = (uint8_t)i;
+            dispatcher.Post((EventId)(i & 3), &value, sizeof(value));
+        }
+        dispatcher.Dispatch();
+    });
+
+    bench.Run("EventDispatcher::Dispatch/all", EventDispatcher_MaxEvents, [&]()
+    {
+        for (uint8_t i = 0; i < EventDispatcher_MaxEvents; i++) { dispatcher.Post(i, &i, sizeof(i)); }
+        BenchKeep(dispatcher.Dispatch());
+    });
+}
@@ -0,0 +1,78 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Bench.h"
+#include "FixedFilter.h"
+#include "MathUtils.h"
+#include "MotionDetector.h"
+
+void RunFixedFilterBenchmarks(Bench &bench)
+{
+    // One 32 sample FIFO burst of accelerometer and gyro x, y, z.
+    const uint16_t burst = 32;
+    int16_t accel[burst * 3];
+    int16_t gyro[burst * 3];
+    for (uint16_t i = 0; i < burst * 3; i++)
+    {
+        accel[i] = (int16_t)((i * 2657) % 8192 - 4096);
+        gyro[i] = (int16_t)((i * 1931) % 12000 - 6000);
+    }
+
+    BiquadCoefficients lowPass[2] =
+    {
+        BiquadCascade::LowPass(20, 1000),
+        BiquadCascade::LowPass(20, 1000),
+    };
+    BiquadState states[2];
+    BiquadCascade cascade(lowPass, states, 2);
+    int16_t filtered[burst * 3];
+
+    bench.Run("BiquadCascade::Process/2 sections", burst, [&]()
+    {
+        for (uint16_t i = 0; i < burst; i++) { filtered[i] = cascade.Process(accel[i * 3]); }
+        BenchKeep(filtered[burst - 1]);
+    });
+
+    bench.Run("BiquadCascade::ProcessBatch/2 sections", burst, [&]()
+    {
+        cascade.ProcessBatch(accel, filtered, burst, 3);
+        BenchKeep(filtered[(burst - 1) * 3]);
+    });
+
+    int16_t window[64];
+    RunningStats stats(window, 64);
+
+    bench.Run("RunningStats::AddBatch", burst, [&]()
+    {
+        stats.AddBatch(accel, burst, 3);
+        BenchKeep(stats.Mean());
+    });
+
+    bench.Run("RunningStats::Variance", 1, [&]()
+    {
+        BenchKeep(stats.Variance());
+    });
+
+    uint16_t magnitudes[burst];
+
+    bench.Run("MathUtils::fixedMagnitude3Batch", burst, [&]()
+    {
+        fixedMagnitude3Batch(gyro, magnitudes, burst);
+        BenchKeep(magnitudes[burst - 1]);
+    });
+
+    MotionDetector detector(BiquadCascade::LowPass(20, 1000), 4000, 6000, 50);
+
+    bench.Run("MotionDetector::Process", burst, [&]()
+    {
+        uint8_t events = 0;
+        for (uint16_t i = 0; i < burst; i++) { events |= detector.Process(&accel[i * 3], &gyro[i * 3]); }
+        BenchKeep(events);
+    });
+
+    bench.Run("MotionDetector::ProcessBatch", burst, [&]()
+    {
+        BenchKeep(detector.ProcessBatch(accel, gyro, burst));
+    });
+}
@@ -0,0 +1,63 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Bench.h"
+#include "IndexedPixelBuffer.h"
+
+void RunIndexedPixelBufferBenchmarks(Bench &bench)
+{
+    const uint16_t stripSizes[] = { 144, 300, 1000 };
+    const uint8_t bitDepths[] = { 4, 8 };
+
+    std::vector<PixelColor> palette(16);
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        palette[i] = PixelColor((uint8_t)(i * 16), (uint8_t)(255 - i * 16), (uint8_t)(i * 5), (uint8_t)i);
+    }
+
+    for (uint16_t size : stripSizes)
+    {
+        std::vector<uint32_t> packed(size);
+
+        for (uint8_t bits : bitDepths)
+        {
+            std::vector<uint8_t> storage(IndexedPixelBuffer::StorageSize(size, bits));
+            IndexedPixelBuffer buffer(&storage[0], size, bits, &palette[0], (uint16_t)palette.size());
+            for (uint16_t i = 0; i < size; i++) { buffer.SetIndex(i, (uint8_t)(i % 16)); }
+
+            std::string suffix = "/" + std::to_string(size) + "/" + std::to_string(bits) + "bit";
+            std::vector<uint32_t> packedPalette(palette.size());
+
+            bench.Run("IndexedPixelBuffer::Pack/lookup" + suffix, size, [&]()
+            {
+                buffer.Pack(&packed[0], PixelType::SK6812_RGBW, &packedPalette[0]);
+                BenchKeep(packed[0]);
+            });
+
+            bench.Run("IndexedPixelBuffer::Pack/direct" + suffix, size, [&]()
+            {
+                buffer.Pack(&packed[0], PixelType::SK6812_RGBW);
+                BenchKeep(packed[0]);
+            });
+
+            // Streamed through a small buffer, as on AVR.
+            bench.Run("IndexedPixelBuffer::Pack/chunk16" + suffix, size, [&]()
+            {
+                for (uint16_t i = 0; i < size; i += 16)
+                {
+                    buffer.Pack(&packed[i], i, 16, PixelType::SK6812_RGBW, &packedPalette[0]);
+                }
+                BenchKeep(packed[0]);
+            });
+
+            bench.Run("IndexedPixelBuffer::SetIndex" + suffix, size, [&]()
+            {
+                for (uint16_t i = 0; i < size; i++) { buffer.SetIndex(i, (uint8_t)(i + 1)); }
+                BenchKeep(storage[0]);
+            });
+        }
+    }
+}
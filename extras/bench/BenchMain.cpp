@@ -0,0 +1,83 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <cstring>
+
+#include "Bench.h"
+
+Bench::Bench(int argc, char **argv)
+    : _csv(false)
+    , _minTimeNs(100e6)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            _csv = true;
+        }
+        else if (strcmp(argv[i], "--quick") == 0)
+        {
+            _minTimeNs = 2e6;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            _filter = argv[++i];
+        }
+    }
+}
+
+void Bench::PrintHeader() const
+{
+    if (_csv)
+    {
+        printf("name,ns_per_op,ops_per_sec\n");
+    }
+    else
+    {
+        printf("%-48s %12s %16s\n", "benchmark", "ns/op", "ops/sec");
+    }
+}
+
+bool Bench::IsSelected(const std::string &name) const
+{
+    return _filter.empty() || name.find(_filter) != std::string::npos;
+}
+
+void Bench::Report(const std::string &name, double nsPerOp) const
+{
+    double opsPerSec = nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0;
+
+    if (_csv)
+    {
+        printf("%s,%.3f,%.0f\n", name.c_str(), nsPerOp, opsPerSec);
+    }
+    else
+    {
+        printf("%-48s %12.3f %16.0f\n", name.c_str(), nsPerOp, opsPerSec);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    Bench bench(argc, argv);
+    bench.PrintHeader();
+
+    RunPixelColorBenchmarks(bench);
+    RunPixelCompositorBenchmarks(bench);
+    RunIndexedPixelBufferBenchmarks(bench);
+    RunParallelRendererBenchmarks(bench);
+    RunParallelStripEncoderBenchmarks(bench);
+    RunAnimationStreamBenchmarks(bench);
+    RunButtonBenchmarks(bench);
+    RunStopwatchBenchmarks(bench);
+    RunTaskRunnerBenchmarks(bench);
+    RunCallbackBenchmarks(bench);
+    RunObjectPoolBenchmarks(bench);
+    RunTraceRecorderBenchmarks(bench);
+    RunMathUtilsBenchmarks(bench);
+    RunFixedFilterBenchmarks(bench);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <string>
+
+#include "Bench.h"
+#include "MathUtils.h"
+
+void RunMathUtilsBenchmarks(Bench &bench)
+{
+    const uint16_t calls = 1000;
+
+    bench.Run("MathUtils::randomBetween", calls, [&]()
+    {
+        for (uint16_t i = 0; i < calls; i++) { BenchKeep(randomBetween(-100, (int32_t)i)); }
+    });
+
+    bench.Run("MathUtils::randomPercent", calls, [&]()
+    {
+        for (uint16_t i = 0; i < calls; i++) { BenchKeep(randomPercent()); }
+    });
+
+    // Two tones plus DC, the kind of input a sound-reactive effect sees.
+    int16_t source[MathUtils_FftMaxSize];
+    for (uint16_t i = 0; i < MathUtils_FftMaxSize; i++)
+    {
+        source[i] = (int16_t)(8000 + (i % 16 < 8 ? 6000 : -6000) + (i % 5) * 1500);
+    }
+
+    int16_t data[MathUtils_FftMaxSize];
+    uint16_t magnitudes[MathUtils_FftMaxSize / 2];
+    uint32_t bands[8];
+
+    for (uint16_t n = MathUtils_FftMinSize; n <= MathUtils_FftMaxSize; n <<= 1)
+    {
+        std::string suffix = "/" + std::to_string(n);
+
+        bench.Run("MathUtils::fixedWindowHann" + suffix, n, [&]()
+        {
+            memcpy(data, source, n * sizeof(int16_t));
+            fixedWindowHann(data, n);
+            BenchKeep(data[n / 2]);
+        });
+
+        bench.Run("MathUtils::fixedRealFft" + suffix, 1, [&]()
+        {
+            memcpy(data, source, n * sizeof(int16_t));
+            fixedRealFft(data, n);
+            BenchKeep(data[2]);
+        });
+
+        bench.Run("MathUtils::fixedBandEnergies" + suffix, 1, [&]()
+        {
+            fixedFftMagnitudes(data, n, magnitudes);
+            fixedBandEnergies(magnitudes, n / 2, bands, 8);
+            BenchKeep(bands[7]);
+        });
+    }
+}
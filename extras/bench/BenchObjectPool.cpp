@@ -0,0 +1,68 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <stdlib.h>
+
+#include "Bench.h"
+#include "EventDispatcher.h"
+#include "FrameArena.h"
+#include "ObjectPool.h"
+
+namespace
+{
+    struct Payload
+    {
+        uint32_t timestamp;
+        int16_t values[6];
+    };
+
+    StaticObjectPool<Payload, 32> payloadPool;
+
+    void OnOwnedPayload(void *arg)
+    {
+        BenchKeep(static_cast<Payload *>(arg)->timestamp);
+        payloadPool.Free(arg);
+    }
+}
+
+void RunObjectPoolBenchmarks(Bench &bench)
+{
+    const uint16_t blocks = 32;
+    Payload *taken[blocks];
+
+    bench.Run("ObjectPool::Allocate+Free", blocks, [&]()
+    {
+        for (uint16_t i = 0; i < blocks; i++) { taken[i] = payloadPool.Allocate(); }
+        for (uint16_t i = 0; i < blocks; i++) { payloadPool.Free(taken[i]); }
+        BenchKeep(taken[blocks - 1]);
+    });
+
+    // The heap baseline the pools replace.
+    bench.Run("malloc+free", blocks, [&]()
+    {
+        for (uint16_t i = 0; i < blocks; i++) { taken[i] = (Payload *)malloc(sizeof(Payload)); }
+        for (uint16_t i = 0; i < blocks; i++) { free(taken[i]); }
+        BenchKeep(taken[blocks - 1]);
+    });
+
+    uint8_t arenaStorage[1024];
+    FrameArena arena(arenaStorage, sizeof(arenaStorage));
+
+    bench.Run("FrameArena::Allocate", blocks, [&]()
+    {
+        arena.Reset();
+        for (uint16_t i = 0; i < blocks; i++) { BenchKeep(arena.Allocate(sizeof(Payload))); }
+    });
+
+    StaticEventDispatcher<1> dispatcher;
+    dispatcher.RegisterEventCallback(1, OnOwnedPayload, PriorityNormal);
+
+    bench.Run("EventDispatcher::PostOwned+Dispatch", 1, [&]()
+    {
+        Payload *payload = payloadPool.Allocate();
+        payload->timestamp = 1;
+        dispatcher.PostOwned(1, payloadPool, payload);
+        BenchKeep(dispatcher.Dispatch());
+    });
+}
@@ -0,0 +1,71 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "ParallelRenderer.h"
+
+namespace
+{
+    struct StripSet
+    {
+        std::vector<std::vector<PixelColor>> pixels;
+        std::vector<std::vector<PixelColor>> targets;
+        std::vector<std::vector<uint32_t>> packed;
+        std::vector<StripRenderJob> jobs;
+    };
+
+    void MakeStrips(StripSet &set, uint16_t stripCount, uint16_t stripSize)
+    {
+        set.pixels.assign(stripCount, std::vector<PixelColor>(stripSize, PixelColor(200, 100, 50, 25)));
+        set.targets.assign(stripCount, std::vector<PixelColor>(stripSize, PixelColor(10, 20, 240, 0)));
+        set.packed.assign(stripCount, std::vector<uint32_t>(stripSize));
+        set.jobs.clear();
+
+        for (uint16_t s = 0; s < stripCount; s++)
+        {
+            StripRenderJob job;
+            job.pixels = &set.pixels[s][0];
+            job.count = stripSize;
+            job.target = &set.targets[s][0];
+            job.morphAlpha = 0.25f;
+            job.scale = 0.9f;
+            job.packed = &set.packed[s][0];
+            job.type = (PixelType)(s % PIXEL_TYPE_Count);
+            set.jobs.push_back(job);
+        }
+    }
+}
+
+void RunParallelRendererBenchmarks(Bench &bench)
+{
+    struct Layout { uint16_t strips; uint16_t size; };
+    const Layout layouts[] = { { 1, 4096 }, { 8, 1000 }, { 32, 300 } };
+
+    unsigned hardware = std::thread::hardware_concurrency();
+    std::vector<uint8_t> threadCounts = { 1, 2, 4 };
+    if (hardware > 4) { threadCounts.push_back((uint8_t)(hardware > 255 ? 255 : hardware)); }
+
+    for (const Layout &layout : layouts)
+    {
+        StripSet set;
+        MakeStrips(set, layout.strips, layout.size);
+        uint64_t pixels = (uint64_t)layout.strips * layout.size;
+
+        for (uint8_t threads : threadCounts)
+        {
+            ParallelRenderer renderer(threads);
+            std::string name = "ParallelRenderer::RenderFrame/"
+                + std::to_string(layout.strips) + "x" + std::to_string(layout.size)
+                + "/threads:" + std::to_string(threads);
+
+            bench.Run(name, pixels, [&]()
+            {
+                renderer.RenderFrame(&set.jobs[0], (uint16_t)set.jobs.size());
+            });
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Bench.h"
+#include "ParallelStripEncoder.h"
+
+namespace
+{
+    // Straightforward bit-at-a-time encoding, for comparison with the transpose.
+    void EncodeNaive(const uint32_t *const *lanes, uint8_t laneCount, uint16_t count, uint8_t bytesPerPixel, uint8_t *out)
+    {
+        uint8_t bits = bytesPerPixel * 8;
+        for (uint16_t p = 0; p < count; p++)
+        {
+            for (uint8_t bit = 0; bit < bits; bit++)
+            {
+                uint8_t value = 0;
+                for (uint8_t lane = 0; lane < laneCount; lane++)
+                {
+                    value |= (uint8_t)(((lanes[lane][p] >> (31 - bit)) & 1) << lane);
+                }
+                *out++ = value;
+            }
+        }
+    }
+}
+
+void RunParallelStripEncoderBenchmarks(Bench &bench)
+{
+    const uint16_t stripSizes[] = { 144, 300 };
+    const PixelType types[] = { PixelType::WS2812b, PixelType::SK6812_RGBW };
+
+    for (uint16_t size : stripSizes)
+    {
+        std::vector<std::vector<uint32_t>> strips(16, std::vector<uint32_t>(size));
+        const uint32_t *lanes[16];
+        for (uint8_t l = 0; l < 16; l++)
+        {
+            for (uint16_t i = 0; i < size; i++) { strips[l][i] = (uint32_t)(i * 2654435761u) ^ (l * 40503u); }
+            lanes[l] = &strips[l][0];
+        }
+
+        for (PixelType type : types)
+        {
+            uint8_t bytesPerPixel = ParallelStripEncoder::BytesPerPixel(type);
+            std::vector<uint8_t> out8(ParallelStripEncoder::EncodedLength(size, type));
+            std::vector<uint16_t> out16(ParallelStripEncoder::EncodedLength(size, type));
+
+            std::string suffix = "/" + std::to_string(size) + (bytesPerPixel == 4 ? "/RGBW" : "/RGB");
+
+            // One op is one pixel of every lane.
+            bench.Run("ParallelStripEncoder::Encode8/8 lanes" + suffix, size, [&]()
+            {
+                ParallelStripEncoder::Encode8(lanes, nullptr, 8, 0, size, type, &out8[0]);
+                BenchKeep(out8[0]);
+            });
+
+            bench.Run("ParallelStripEncoder::Naive/8 lanes" + suffix, size, [&]()
+            {
+                EncodeNaive(lanes, 8, size, bytesPerPixel, &out8[0]);
+                BenchKeep(out8[0]);
+            });
+
+            bench.Run("ParallelStripEncoder::Encode16/16 lanes" + suffix, size, [&]()
+            {
+                ParallelStripEncoder::Encode16(lanes, nullptr, 16, 0, size, type, &out16[0]);
+                BenchKeep(out16[0]);
+            });
+        }
+    }
+}
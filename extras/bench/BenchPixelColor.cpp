@@ -0,0 +1,102 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Bench.h"
+#include "PixelColor.h"
+#include "PixelColorTable.h"
+
+namespace
+{
+    const uint16_t stripSizes[] = { 1, 60, 144, 300, 1000 };
+
+    const char *pixelTypeNames[PIXEL_TYPE_Count] =
+    {
+        "WS2812b", "WS2812b_GR", "WS2813", "SK6812", "SK6812_GR", "SK6812_RGBW",
+    };
+
+    std::vector<PixelColor> MakeStrip(uint16_t size)
+    {
+        std::vector<PixelColor> strip(size);
+        for (uint16_t i = 0; i < size; i++)
+        {
+            strip[i] = PixelColor((uint8_t)(i * 7), (uint8_t)(i * 13), (uint8_t)(i * 29), (uint8_t)i);
+        }
+        return strip;
+    }
+
+    const PixelColor presetColors[] PixelColorTable_PROGMEM =
+    {
+        PixelColor(0, 0, 255), PixelColor(255, 0, 0), PixelColor(0, 255, 0), PixelColor(128, 0, 255),
+        PixelColor(255, 128, 0), PixelColor(0, 255, 255), PixelColor(255, 255, 255), PixelColor(0, 0, 0, 255),
+    };
+    constexpr PixelColorTable presets(presetColors, 8);
+
+    std::string Name(const char *op, uint16_t size)
+    {
+        return std::string("PixelColor::") + op + "/" + std::to_string(size);
+    }
+}
+
+void RunPixelColorBenchmarks(Bench &bench)
+{
+    for (uint16_t size : stripSizes)
+    {
+        std::vector<PixelColor> strip = MakeStrip(size);
+        std::vector<PixelColor> other = MakeStrip(size);
+        std::vector<PixelColor> out(size);
+
+        // ScaleColor is destructive, so each call scales a fresh copy; the copy cost
+        // is the CopyFromColor row below.
+        bench.Run(Name("ScaleColor", size), size, [&]()
+        {
+            for (uint16_t i = 0; i < size; i++) { out[i].CopyFromColor(&strip[i])->ScaleColor(0.75f); }
+            BenchKeep(out[0]);
+        });
+
+        bench.Run(Name("CopyFromColor", size), size, [&]()
+        {
+            for (uint16_t i = 0; i < size; i++) { out[i].CopyFromColor(&strip[i], 0.5f); }
+            BenchKeep(out[0]);
+        });
+
+        bench.Run(Name("Morph", size), size, [&]()
+        {
+            for (uint16_t i = 0; i < size; i++) { out[i].Morph(&strip[i], &other[size - 1 - i], 0.37f); }
+            BenchKeep(out[0]);
+        });
+
+        bench.Run("PixelColorTable::At/" + std::to_string(size), size, [&]()
+        {
+            for (uint16_t i = 0; i < size; i++) { out[i] = presets.At(i & 7); }
+            BenchKeep(out[0]);
+        });
+
+        std::vector<uint32_t> packed(size);
+        for (uint8_t type = 0; type < PIXEL_TYPE_Count; type++)
+        {
+            std::string name = Name("PackedValue", size) + "/" + pixelTypeNames[type];
+            bench.Run(name, size, [&]()
+            {
+                for (uint16_t i = 0; i < size; i++) { packed[i] = strip[i].PackedValue((PixelType)type); }
+                BenchKeep(packed[0]);
+            });
+        }
+
+        bench.Run(Name("PackStrip", size) + "/SK6812_RGBW", size, [&]()
+        {
+            PixelColor::PackStrip(&strip[0], &packed[0], size, PixelType::SK6812_RGBW);
+            BenchKeep(packed[0]);
+        });
+
+        // White extraction plus a warm color temperature correction, in the packing pass.
+        const PixelCorrection correction = { WhiteExtraction::WhiteReplace, 256, 224, 180, 240 };
+        bench.Run(Name("PackStrip", size) + "/SK6812_RGBW/corrected", size, [&]()
+        {
+            PixelColor::PackStrip(&strip[0], &packed[0], size, PixelType::SK6812_RGBW, &correction);
+            BenchKeep(packed[0]);
+        });
+    }
+}
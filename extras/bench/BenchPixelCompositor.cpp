@@ -0,0 +1,56 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Bench.h"
+#include "PixelCompositor.h"
+
+void RunPixelCompositorBenchmarks(Bench &bench)
+{
+    const uint16_t stripSizes[] = { 60, 144, 300, 1000 };
+
+    for (uint16_t size : stripSizes)
+    {
+        std::vector<PixelColor> flicker(size);
+        for (uint16_t i = 0; i < size; i++) { flicker[i] = PixelColor((uint8_t)(i * 31), 0, (uint8_t)(i * 17)); }
+
+        PixelColor base(0, 80, 255);
+        PixelColor flash(255, 255, 255, 255);
+        std::vector<PixelColor> out(size);
+
+        // Blade color, a flicker buffer on top and a clash flash over the tip.
+        StaticPixelCompositor<3> compositor;
+        compositor.AddSolidLayer(BlendMode::BlendBase, base);
+        int8_t flickerLayer = compositor.AddLayer(BlendMode::BlendScreen, &flicker[0]);
+        int8_t flashLayer = compositor.AddSolidLayer(BlendMode::BlendAlphaOver, flash);
+        compositor.SetOpacity(flickerLayer, 96);
+        compositor.SetOpacity(flashLayer, 160);
+        compositor.SetRange(flashLayer, size / 2, PixelCompositor_RangeEnd);
+
+        std::string suffix = "/" + std::to_string(size);
+
+        bench.Run("PixelCompositor::Render/3 layers" + suffix, size, [&]()
+        {
+            compositor.Render(&out[0], size);
+            BenchKeep(out[0]);
+        });
+
+        // The same frame built with the pairwise Morph passes it replaces.
+        bench.Run("PixelCompositor::MorphPasses/3 layers" + suffix, size, [&]()
+        {
+            for (uint16_t i = 0; i < size; i++) { out[i].CopyFromColor(&base); }
+            for (uint16_t i = 0; i < size; i++) { out[i].Morph(&flicker[i], 0.375f); }
+            for (uint16_t i = size / 2; i < size; i++) { out[i].Morph(&flash, 0.625f); }
+            BenchKeep(out[0]);
+        });
+
+        compositor.SetEnabled(flashLayer, false);
+        bench.Run("PixelCompositor::Render/flash disabled" + suffix, size, [&]()
+        {
+            compositor.Render(&out[0], size);
+            BenchKeep(out[0]);
+        });
+    }
+}
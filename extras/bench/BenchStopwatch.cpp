@@ -0,0 +1,31 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Bench.h"
+#include "Stopwatch.h"
+
+void RunStopwatchBenchmarks(Bench &bench)
+{
+    const uint16_t updates = 1000;
+
+    HostArduino::Reset();
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    bench.Run("Stopwatch::Update", updates, [&]()
+    {
+        for (uint16_t i = 0; i < updates; i++)
+        {
+            HostArduino::AdvanceMicros(250);
+            stopwatch.Update();
+        }
+        BenchKeep(stopwatch.ElapsedTime());
+    });
+
+    bench.Run("Stopwatch::HasElapsed", updates, [&]()
+    {
+        for (uint16_t i = 0; i < updates; i++) { BenchKeep(stopwatch.HasElapsed(i)); }
+    });
+}
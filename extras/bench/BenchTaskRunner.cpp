@@ -0,0 +1,60 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Bench.h"
+#include "TaskRunner.h"
+
+namespace
+{
+    // Blinks forever with its own period, like a bank of independent indicator
+    // sequences.
+    int8_t Blink(Task &task)
+    {
+        TaskRunner_Begin(task);
+        for (;;)
+        {
+            task.counter++;
+            TaskRunner_WaitMS(task, (uint32_t)(uintptr_t)task.arg);
+        }
+        TaskRunner_End(task);
+    }
+
+    int8_t OneShot(Task &task)
+    {
+        TaskRunner_Begin(task);
+        TaskRunner_Yield(task);
+        TaskRunner_End(task);
+    }
+
+    StaticTaskRunner<300> runner;
+}
+
+void RunTaskRunnerBenchmarks(Bench &bench)
+{
+    const uint16_t tasks = 300;
+
+    HostArduino::Reset();
+    for (uint16_t i = 0; i < tasks; i++)
+    {
+        runner.Start(Blink, (void *)(uintptr_t)(50 + (i * 37) % 950));
+    }
+    runner.Run();
+
+    // With 1ms frames only a handful of the 300 sleepers are due on each Run.
+    bench.Run("TaskRunner::Run/300 sleeping", 1, [&]()
+    {
+        HostArduino::AdvanceMicros(1000);
+        BenchKeep(runner.Run());
+    });
+
+    for (uint16_t i = 0; i < tasks; i++) { runner.Cancel((int16_t)i); }
+    runner.Run();
+
+    bench.Run("TaskRunner::Start+Yield+End", 1, [&]()
+    {
+        runner.Start(OneShot);
+        runner.Run();
+        BenchKeep(runner.Run());
+    });
+}
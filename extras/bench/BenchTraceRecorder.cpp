@@ -0,0 +1,68 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Bench.h"
+#include "TraceRecorder.h"
+#include "TraceReplayer.h"
+
+void RunTraceRecorderBenchmarks(Bench &bench)
+{
+    const uint16_t records = 1000;
+
+    HostArduino::Reset();
+
+    std::vector<TraceRecord> buffer(256);
+    TraceRecorder recorder(&buffer[0], (uint16_t)buffer.size());
+    recorder.Start();
+
+    bench.Run("TraceRecorder::RecordCallback", records, [&]()
+    {
+        for (uint16_t i = 0; i < records; i++)
+        {
+            HostArduino::AdvanceMicros(1000);
+            recorder.RecordCallback((uint8_t)i, i);
+        }
+    });
+
+    Stopwatch probe;
+    probe.Start();
+    bench.Run("TraceRecorder::RecordProbe", records, [&]()
+    {
+        for (uint16_t i = 0; i < records; i++) { recorder.RecordProbe(1, probe); }
+    });
+
+    std::vector<uint8_t> out(recorder.SerializedSize());
+    bench.Run("TraceRecorder::Serialize/256", buffer.size(), [&]()
+    {
+        BenchKeep(recorder.Serialize(&out[0], (uint32_t)out.size()));
+    });
+
+    // A minute of a 100 Hz loop with a press every second, replayed through the
+    // button that recorded it.
+    HostArduino::Reset();
+    Button button(2, ButtonType::Momentary, ButtonPolarity::ActiveLow, 500);
+    std::vector<TraceRecord> session(4096);
+    TraceRecorder sessionRecorder(&session[0], (uint16_t)session.size());
+    HostArduino::SetPinLevel(2, HIGH);
+    sessionRecorder.Start();
+    for (uint32_t ms = 10; ms <= 60000; ms += 10)
+    {
+        HostArduino::SetMillis(ms);
+        HostArduino::SetPinLevel(2, ms % 1000 < 100 ? LOW : HIGH);
+        sessionRecorder.SampleButton(button);
+    }
+
+    std::vector<uint8_t> trace(sessionRecorder.SerializedSize());
+    sessionRecorder.Serialize(&trace[0], (uint32_t)trace.size());
+
+    TraceReplayer replayer;
+    replayer.Load(&trace[0], trace.size());
+    replayer.AttachButton(&button, 2, ButtonPolarity::ActiveLow);
+    bench.Run("TraceReplayer::Replay/60s", replayer.Count(), [&]()
+    {
+        BenchKeep(replayer.Replay(10).stateMismatches);
+    });
+}
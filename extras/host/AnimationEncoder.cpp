@@ -0,0 +1,204 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "AnimationEncoder.h"
+
+namespace
+{
+    bool SameColor(const PixelColor &a, const PixelColor &b)
+    {
+        return a.Red() == b.Red()
+            && a.Green() == b.Green()
+            && a.Blue() == b.Blue()
+            && a.White() == b.White();
+    }
+}
+
+AnimationEncoder::AnimationEncoder(
+    uint16_t pixelCount,
+    uint16_t frameDurationMS,
+    const PixelColor *palette,
+    uint8_t paletteSize)
+    : _previous(pixelCount)
+    , _pixelCount(pixelCount)
+    , _frameCount(0)
+{
+    if (palette != nullptr)
+    {
+        this->_palette.assign(palette, palette + paletteSize);
+    }
+
+    uint8_t header[AnimationStream_HeaderSize] =
+    {
+        'C', 'G', 'A', AnimationStream_Version,
+        (uint8_t)pixelCount, (uint8_t)(pixelCount >> 8),
+        0, 0,
+        (uint8_t)frameDurationMS, (uint8_t)(frameDurationMS >> 8),
+        (uint8_t)this->_palette.size(),
+    };
+    this->_data.assign(header, header + AnimationStream_HeaderSize);
+
+    for (const PixelColor &color : this->_palette)
+    {
+        this->_data.push_back(color.Red());
+        this->_data.push_back(color.Green());
+        this->_data.push_back(color.Blue());
+        this->_data.push_back(color.White());
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t AnimationEncoder::FrameCount() const
+{
+    return this->_frameCount;
+}
+
+const std::vector<uint8_t>& AnimationEncoder::Data() const
+{
+    return this->_data;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void AnimationEncoder::AddFrame(const PixelColor *pixels, bool isKeyframe)
+{
+    isKeyframe = isKeyframe || this->_frameCount == 0;
+
+    if (isKeyframe)
+    {
+        // The decoder clears to black on a keyframe, so encode against black.
+        this->_data.push_back(AnimationOp_Key << 5);
+        for (PixelColor &p : this->_previous) { p = PixelColor(); }
+    }
+
+    uint16_t i = 0;
+    uint16_t pendingSkip = 0;
+    while (i < this->_pixelCount)
+    {
+        if (SameColor(pixels[i], this->_previous[i]))
+        {
+            pendingSkip++;
+            i++;
+            continue;
+        }
+
+        // Only emit a skip once something after it changes; trailing skips are free.
+        EmitSkip(pendingSkip);
+        pendingSkip = 0;
+
+        uint16_t run = 1;
+        while (i + run < this->_pixelCount
+            && SameColor(pixels[i + run], pixels[i])
+            && !SameColor(pixels[i + run], this->_previous[i + run]))
+        {
+            run++;
+        }
+
+        if (run >= 2 || PaletteIndex(pixels[i]) < 0)
+        {
+            EmitRun(pixels[i], run);
+            i += run;
+            continue;
+        }
+
+        // Literal palette indices until a pixel is unchanged, not in the palette or
+        // starts a run of its own.
+        uint16_t start = i;
+        uint16_t literal = 0;
+        while (i < this->_pixelCount
+            && literal < AnimationOp_MaxCount
+            && !SameColor(pixels[i], this->_previous[i])
+            && PaletteIndex(pixels[i]) >= 0
+            && (literal == 0 || i + 1 >= this->_pixelCount || !SameColor(pixels[i + 1], pixels[i])))
+        {
+            literal++;
+            i++;
+        }
+
+        EmitOp(AnimationOp_Index, literal);
+        for (uint16_t k = start; k < start + literal; k++)
+        {
+            this->_data.push_back((uint8_t)PaletteIndex(pixels[k]));
+        }
+    }
+
+    this->_data.push_back(AnimationOp_End << 5);
+    this->_previous.assign(pixels, pixels + this->_pixelCount);
+
+    this->_frameCount++;
+    this->_data[6] = (uint8_t)this->_frameCount;
+    this->_data[7] = (uint8_t)(this->_frameCount >> 8);
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+int16_t AnimationEncoder::PaletteIndex(const PixelColor &color) const
+{
+    for (size_t i = 0; i < this->_palette.size(); i++)
+    {
+        if (SameColor(this->_palette[i], color)) { return (int16_t)i; }
+    }
+
+    return -1;
+}
+
+void AnimationEncoder::EmitOp(uint8_t op, uint16_t count)
+{
+    this->_data.push_back((uint8_t)((op << 5) | (count - 1)));
+}
+
+void AnimationEncoder::EmitSkip(uint16_t count)
+{
+    while (count > AnimationOp_MaxCount)
+    {
+        uint16_t chunk = count > 0x2000 ? 0x2000 : count;
+        this->_data.push_back((uint8_t)((AnimationOp_SkipLong << 5) | ((chunk - 1) >> 8)));
+        this->_data.push_back((uint8_t)(chunk - 1));
+        count -= chunk;
+    }
+
+    if (count > 0) { EmitOp(AnimationOp_Skip, count); }
+}
+
+void AnimationEncoder::EmitRun(const PixelColor &color, uint16_t count)
+{
+    int16_t index = PaletteIndex(color);
+
+    while (count > 0)
+    {
+        uint16_t chunk = count > AnimationOp_MaxCount ? AnimationOp_MaxCount : count;
+
+        if (index >= 0)
+        {
+            EmitOp(AnimationOp_Run, chunk);
+            this->_data.push_back((uint8_t)index);
+        }
+        else
+        {
+            bool hasWhite = color.White() != 0;
+            EmitOp(hasWhite ? AnimationOp_Rgbw : AnimationOp_Rgb, chunk);
+            this->_data.push_back(color.Red());
+            this->_data.push_back(color.Green());
+            this->_data.push_back(color.Blue());
+            if (hasWhite) { this->_data.push_back(color.White()); }
+        }
+
+        count -= chunk;
+    }
+}
+
+// ------------------------------------------------------------------------------------
@@ -0,0 +1,87 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    AnimationEncoder.h
+  * @author  Naigon's Electronic Creations
+  * @brief   AnimationEncoder
+  *          Host-side encoder producing the stream format decoded by AnimationStream
+  *          (see src/AnimationStream.h for the layout). Frames are added one at a
+  *          time as full pixel arrays; each is stored as the difference from the
+  *          frame before it unless it is marked as a keyframe.
+  *
+  *          Colors found in the palette are stored as indices; any other color is
+  *          stored directly, so a palette is optional.
+  *************************************************************************************
+**/
+
+#ifndef __AnimationEncoder_H_
+#define __AnimationEncoder_H_
+
+#include <vector>
+
+#include "Arduino.h"
+#include "AnimationStream.h"
+#include "PixelColor.h"
+
+class AnimationEncoder
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the AnimationEncoder class.
+     *
+     * @param   pixelCount
+     *          Pixels per frame.
+     *
+     * @param   frameDurationMS
+     *          Intended time each frame is shown for.
+     *
+     * @param   palette
+     *          Palette colors, or nullptr for none.
+     *
+     * @param   paletteSize
+     *          Number of palette colors; at most 255.
+     **/
+    AnimationEncoder(
+        uint16_t pixelCount,
+        uint16_t frameDurationMS,
+        const PixelColor *palette = nullptr,
+        uint8_t paletteSize = 0);
+
+    /**
+     * @brief   Append a frame. The first frame is always stored as a keyframe.
+     *
+     * @param   pixels
+     *          pixelCount pixels.
+     *
+     * @param   isKeyframe
+     *          Store the frame so decoding can start from it, instead of as a delta.
+     **/
+    void AddFrame(const PixelColor *pixels, bool isKeyframe = false);
+
+    /**
+     * @brief   Number of frames added.
+     **/
+    uint16_t FrameCount() const;
+
+    /**
+     * @brief   The encoded stream, ready for AnimationStream::Open.
+     **/
+    const std::vector<uint8_t>& Data() const;
+
+  private:
+    int16_t PaletteIndex(const PixelColor &color) const;
+    void EmitOp(uint8_t op, uint16_t count);
+    void EmitSkip(uint16_t count);
+    void EmitRun(const PixelColor &color, uint16_t count);
+
+    std::vector<uint8_t> _data;
+    std::vector<PixelColor> _palette;
+    std::vector<PixelColor> _previous;
+    uint16_t _pixelCount;
+    uint16_t _frameCount;
+};
+
+#endif //__AnimationEncoder_H_
@@ -0,0 +1,85 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Arduino.h"
+
+#define HostArduino_PinCount 256
+
+namespace
+{
+    uint64_t virtualMicros = 0;
+    uint8_t pinLevels[HostArduino_PinCount] = { 0 };
+
+    // Small LCG instead of the C library so sequences are identical on every host.
+    uint32_t randomState = 1;
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(uint32_t)(virtualMicros / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)(uint32_t)virtualMicros;
+}
+
+void pinMode(uint32_t, uint32_t)
+{
+}
+
+int digitalRead(uint32_t pin)
+{
+    return pin < HostArduino_PinCount ? pinLevels[pin] : LOW;
+}
+
+void digitalWrite(uint32_t pin, uint32_t value)
+{
+    HostArduino::SetPinLevel(pin, (int)value);
+}
+
+long random(long howBig)
+{
+    if (howBig <= 0) { return 0; }
+
+    randomState = randomState * 1664525u + 1013904223u;
+    return (long)((randomState >> 8) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig)
+{
+    if (howSmall >= howBig) { return howSmall; }
+    return random(howBig - howSmall) + howSmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0) { randomState = (uint32_t)seed; }
+}
+
+namespace HostArduino
+{
+    void SetMillis(uint32_t ms)
+    {
+        virtualMicros = (uint64_t)ms * 1000;
+    }
+
+    void AdvanceMicros(uint32_t us)
+    {
+        virtualMicros += us;
+    }
+
+    void SetPinLevel(uint32_t pin, int level)
+    {
+        if (pin >= HostArduino_PinCount) { return; }
+        pinLevels[pin] = level == LOW ? LOW : HIGH;
+    }
+
+    void Reset()
+    {
+        virtualMicros = 0;
+        memset(pinLevels, LOW, sizeof(pinLevels));
+        randomState = 1;
+    }
+}
@@ -0,0 +1,73 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    Arduino.h
+  * @author  Naigon's Electronic Creations
+  * @brief   Host Arduino shim
+  *          Minimal stand-in for the Arduino core so the library can be compiled and
+  *          run on a desktop machine. Time is virtual: millis() and micros() only move
+  *          when the HostArduino clock functions are called, and digitalRead returns
+  *          whatever level was last set for the pin. This lets recorded traces be
+  *          replayed deterministically.
+  *
+  *          Only put this directory on the include path for host builds.
+  *************************************************************************************
+**/
+
+#ifndef __HostArduino_H_
+#define __HostArduino_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LOW 0x0
+#define HIGH 0x1
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+
+void pinMode(uint32_t pin, uint32_t mode);
+int digitalRead(uint32_t pin);
+void digitalWrite(uint32_t pin, uint32_t value);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+namespace HostArduino
+{
+    /**
+     * @brief   Set the virtual clock. micros() is set to the matching value.
+     **/
+    void SetMillis(uint32_t ms);
+
+    /**
+     * @brief   Move the virtual clock forward by the given number of micros.
+     **/
+    void AdvanceMicros(uint32_t us);
+
+    /**
+     * @brief   Set the level returned by digitalRead for a pin.
+     **/
+    void SetPinLevel(uint32_t pin, int level);
+
+    /**
+     * @brief   Reset the clock to zero (0), all pins to LOW and the random seed.
+     **/
+    void Reset();
+}
+
+#endif //__HostArduino_H_
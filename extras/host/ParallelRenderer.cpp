@@ -0,0 +1,156 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "ParallelRenderer.h"
+
+ParallelRenderer::ParallelRenderer(uint8_t threadCount, uint16_t segmentSize)
+    : _segmentSize(segmentSize == 0 ? ParallelRenderer_DefaultSegmentSize : segmentSize)
+    , _generation(0)
+    , _busyWorkers(0)
+    , _isStopping(false)
+    , _nextSegment(0)
+{
+    if (threadCount == 0)
+    {
+        unsigned hardware = std::thread::hardware_concurrency();
+        threadCount = (uint8_t)(hardware == 0 ? 1 : (hardware > 255 ? 255 : hardware));
+    }
+
+    // The thread calling RenderFrame does its share, so start one less.
+    for (uint8_t i = 1; i < threadCount; i++)
+    {
+        this->_workers.emplace_back(&ParallelRenderer::WorkerLoop, this);
+    }
+}
+
+ParallelRenderer::~ParallelRenderer()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_isStopping = true;
+    }
+    this->_frameStart.notify_all();
+
+    for (std::thread &worker : this->_workers)
+    {
+        worker.join();
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint8_t ParallelRenderer::ThreadCount() const
+{
+    return (uint8_t)(this->_workers.size() + 1);
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void ParallelRenderer::RenderFrame(const StripRenderJob *jobs, uint16_t jobCount)
+{
+    this->_segments.clear();
+    for (uint16_t j = 0; j < jobCount; j++)
+    {
+        for (uint32_t start = 0; start < jobs[j].count; start += this->_segmentSize)
+        {
+            uint32_t end = start + this->_segmentSize;
+            Segment segment = { &jobs[j], (uint16_t)start, (uint16_t)(end < jobs[j].count ? end : jobs[j].count) };
+            this->_segments.push_back(segment);
+        }
+    }
+
+    if (this->_workers.empty() || this->_segments.size() <= 1)
+    {
+        for (const Segment &segment : this->_segments)
+        {
+            RenderSegment(*segment.job, segment.start, segment.end);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_nextSegment.store(0, std::memory_order_relaxed);
+        this->_busyWorkers = (uint8_t)this->_workers.size();
+        this->_generation++;
+    }
+    this->_frameStart.notify_all();
+
+    RunSegments();
+
+    // Frame barrier: every worker has finished its last segment.
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_frameDone.wait(lock, [this]() { return this->_busyWorkers == 0; });
+}
+
+void ParallelRenderer::RenderSegment(const StripRenderJob &job, uint16_t start, uint16_t end)
+{
+    PixelColor *pixels = job.pixels;
+
+    for (uint16_t i = start; i < end; i++)
+    {
+        if (job.target != nullptr) { pixels[i].Morph(&job.target[i], job.morphAlpha); }
+        if (job.scale != 1.0f) { pixels[i].ScaleColor(job.scale); }
+        if (job.packed != nullptr) { job.packed[i] = pixels[i].PackedValue(job.type); }
+    }
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+void ParallelRenderer::WorkerLoop()
+{
+    uint32_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_frameStart.wait(lock, [this, seenGeneration]()
+            {
+                return this->_isStopping || this->_generation != seenGeneration;
+            });
+
+            if (this->_isStopping) { return; }
+            seenGeneration = this->_generation;
+        }
+
+        RunSegments();
+
+        bool isLast;
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            isLast = --this->_busyWorkers == 0;
+        }
+
+        if (isLast) { this->_frameDone.notify_one(); }
+    }
+}
+
+void ParallelRenderer::RunSegments()
+{
+    size_t count = this->_segments.size();
+
+    while (true)
+    {
+        size_t index = this->_nextSegment.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) { return; }
+
+        const Segment &segment = this->_segments[index];
+        RenderSegment(*segment.job, segment.start, segment.end);
+    }
+}
+
+// ------------------------------------------------------------------------------------
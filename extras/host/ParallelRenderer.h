@@ -0,0 +1,126 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    ParallelRenderer.h
+  * @author  Naigon's Electronic Creations
+  * @brief   ParallelRenderer
+  *          Renders many strips per frame on a pool of worker threads, for host and
+  *          multi-core Linux controllers. Each strip job is split into fixed size
+  *          segments which the workers (and the calling thread) pull from a shared
+  *          counter, so one long strip scales as well as many short ones.
+  *
+  *          RenderFrame is the frame barrier: it returns only once every segment of
+  *          every job is done, so the output can be sent right after.
+  *
+  *          Requires std::thread; not available on the AVR build.
+  *************************************************************************************
+**/
+
+#ifndef __ParallelRenderer_H_
+#define __ParallelRenderer_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+#define ParallelRenderer_DefaultSegmentSize 256
+
+// Work for one strip in a frame. Steps run per pixel in this order, each one skipped
+// when not requested.
+struct StripRenderJob
+{
+    // Strip pixels; modified in place.
+    PixelColor *pixels;
+    uint16_t count;
+
+    // Morph each pixel toward target[i] by morphAlpha. nullptr to skip.
+    const PixelColor *target;
+    float morphAlpha;
+
+    // ScaleColor by this amount. 1.0f to skip.
+    float scale;
+
+    // Write PackedValue(type) of each pixel here. nullptr to skip.
+    uint32_t *packed;
+    PixelType type;
+};
+
+class ParallelRenderer
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the ParallelRenderer class and starts its
+     *          workers.
+     *
+     * @param   threadCount
+     *          Total threads used to render, including the caller of RenderFrame.
+     *          Zero (0) uses one per hardware thread. One (1) renders inline.
+     *
+     * @param   segmentSize
+     *          Pixels per unit of work.
+     **/
+    explicit ParallelRenderer(
+        uint8_t threadCount = 0,
+        uint16_t segmentSize = ParallelRenderer_DefaultSegmentSize);
+
+    ~ParallelRenderer();
+
+    ParallelRenderer(const ParallelRenderer&) = delete;
+    ParallelRenderer& operator=(const ParallelRenderer&) = delete;
+
+    /**
+     * @brief   Total number of threads rendering a frame, including the caller.
+     **/
+    uint8_t ThreadCount() const;
+
+    /**
+     * @brief   Render all jobs and wait for them to complete.
+     *
+     * @param   jobs
+     *          Jobs to render. Jobs must not share pixel or packed buffers.
+     *
+     * @param   jobCount
+     *          Number of jobs.
+     **/
+    void RenderFrame(const StripRenderJob *jobs, uint16_t jobCount);
+
+    /**
+     * @brief   Render pixels [start, end) of one job on the calling thread. This is
+     *          the kernel every worker runs.
+     **/
+    static void RenderSegment(const StripRenderJob &job, uint16_t start, uint16_t end);
+
+  private:
+    struct Segment
+    {
+        const StripRenderJob *job;
+        uint16_t start;
+        uint16_t end;
+    };
+
+    void WorkerLoop();
+    void RunSegments();
+
+    std::vector<std::thread> _workers;
+    std::vector<Segment> _segments;
+    uint16_t _segmentSize;
+
+    std::mutex _mutex;
+    std::condition_variable _frameStart;
+    std::condition_variable _frameDone;
+    uint32_t _generation;
+    uint8_t _busyWorkers;
+    bool _isStopping;
+
+    std::atomic<size_t> _nextSegment;
+};
+
+#endif //__ParallelRenderer_H_
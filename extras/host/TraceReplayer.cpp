@@ -0,0 +1,190 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "TraceReplayer.h"
+
+TraceReplayer::TraceReplayer()
+{
+}
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+bool TraceReplayer::Load(const uint8_t *data, size_t size)
+{
+    this->_records.clear();
+
+    if (size < TraceRecorder_HeaderSize
+        || data[0] != 'C' || data[1] != 'G' || data[2] != 'T'
+        || data[3] != TraceRecorder_Version)
+    {
+        return false;
+    }
+
+    uint16_t count = (uint16_t)(data[4] | (data[5] << 8));
+    if (size < TraceRecorder_HeaderSize + (size_t)count * TraceRecorder_RecordSize)
+    {
+        return false;
+    }
+
+    const uint8_t *p = data + TraceRecorder_HeaderSize;
+    this->_records.reserve(count);
+    for (uint16_t i = 0; i < count; i++, p += TraceRecorder_RecordSize)
+    {
+        TraceRecord record;
+        record.deltaMS = (uint16_t)(p[0] | (p[1] << 8));
+        record.kind = p[2];
+        record.id = p[3];
+        record.value = (uint16_t)(p[4] | (p[5] << 8));
+        this->_records.push_back(record);
+    }
+
+    return true;
+}
+
+size_t TraceReplayer::Count() const
+{
+    return this->_records.size();
+}
+
+void TraceReplayer::AttachButton(Button *button, uint32_t pin, ButtonPolarity polarity)
+{
+    ReplayButton entry = { button, pin, polarity };
+    this->_buttons.push_back(entry);
+}
+
+void TraceReplayer::AttachCallback(uint8_t sourceId, CallbackHandler *handler)
+{
+    ReplayCallback entry = { sourceId, handler };
+    this->_callbacks.push_back(entry);
+}
+
+TraceReplayResult TraceReplayer::Replay(uint32_t pollIntervalMS)
+{
+    TraceReplayResult result;
+    memset(&result, 0, sizeof(result));
+
+    if (pollIntervalMS == 0) { pollIntervalMS = 1; }
+
+    HostArduino::Reset();
+    for (ReplayButton &b : this->_buttons)
+    {
+        HostArduino::SetPinLevel(b.pin, b.polarity == ButtonPolarity::ActiveLow ? HIGH : LOW);
+    }
+
+    std::vector<StateEvent> recorded;
+    std::vector<StateEvent> replayed;
+
+    uint32_t now = 0;
+    uint32_t nextPoll = pollIntervalMS;
+
+    for (const TraceRecord &record : this->_records)
+    {
+        uint32_t target = now + record.deltaMS;
+
+        // Run the normal loop polling up to the time of this record.
+        while (nextPoll < target)
+        {
+            HostArduino::SetMillis(nextPoll);
+            for (ReplayButton &b : this->_buttons) { Poll(b, replayed); }
+            nextPoll += pollIntervalMS;
+        }
+
+        now = target;
+        HostArduino::SetMillis(now);
+        result.records++;
+
+        switch (record.kind)
+        {
+            case TraceKind::TraceButton:
+            {
+                uint8_t state = (uint8_t)(record.value & 0xFF);
+                if (state != ButtonState::NotPressed)
+                {
+                    StateEvent event = { record.id, state };
+                    recorded.push_back(event);
+                }
+
+                // The board sampled this button right here, so apply the level and
+                // sample it the same way.
+                ReplayButton *b = FindButton(record.id);
+                if (b == nullptr) { break; }
+
+                bool isPressed = (record.value & TraceRecorder_ButtonPressedFlag) != 0;
+                bool activeHigh = b->polarity == ButtonPolarity::ActiveHigh;
+                HostArduino::SetPinLevel(b->pin, isPressed == activeHigh ? HIGH : LOW);
+                Poll(*b, replayed);
+                break;
+            }
+            case TraceKind::TraceCallback:
+            {
+                for (ReplayCallback &c : this->_callbacks)
+                {
+                    if (c.sourceId != record.id) { continue; }
+
+                    uint16_t value = record.value;
+                    c.handler->FireCallback(&value);
+                    result.callbacksFired++;
+                }
+                break;
+            }
+            case TraceKind::TraceProbe:
+            {
+                result.probes++;
+                result.probeTotalMicros += record.value;
+                if (record.value > result.probeMaxMicros)
+                {
+                    result.probeMaxMicros = record.value;
+                }
+                break;
+            }
+            case TraceKind::TraceTimeGap:
+            default:
+                break;
+        }
+    }
+
+    result.durationMS = now;
+    result.recordedStates = (uint32_t)recorded.size();
+    result.replayedStates = (uint32_t)replayed.size();
+
+    size_t common = recorded.size() < replayed.size() ? recorded.size() : replayed.size();
+    for (size_t i = 0; i < common; i++)
+    {
+        if (!(recorded[i] == replayed[i])) { result.stateMismatches++; }
+    }
+    result.stateMismatches += (uint32_t)(recorded.size() + replayed.size() - 2 * common);
+
+    return result;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+TraceReplayer::ReplayButton *TraceReplayer::FindButton(uint8_t buttonId)
+{
+    for (ReplayButton &b : this->_buttons)
+    {
+        if (b.button->Id() == buttonId) { return &b; }
+    }
+
+    return nullptr;
+}
+
+void TraceReplayer::Poll(ReplayButton &button, std::vector<StateEvent> &replayed)
+{
+    ButtonState state = button.button->DetermineButtonState();
+    if (state != ButtonState::NotPressed)
+    {
+        StateEvent event = { button.button->Id(), (uint8_t)state };
+        replayed.push_back(event);
+    }
+}
+
+// ------------------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    TraceReplayer.h
+  * @author  Naigon's Electronic Creations
+  * @brief   TraceReplayer
+  *          Host-side replay of a trace written by TraceRecorder::Serialize. Time runs
+  *          on the virtual clock of the host Arduino shim, so a replay is fully
+  *          deterministic and runs as fast as the host allows.
+  *
+  *          Recorded pin levels are applied to the attached buttons, which are polled
+  *          at a fixed interval exactly as on the board. The decoded ButtonStates are
+  *          compared to the recorded ones. Recorded callback firings are fired again
+  *          through the attached CallbackHandler instances, and recorded Stopwatch
+  *          probe results are summarized so a field capture can serve as a baseline.
+  *************************************************************************************
+**/
+
+#ifndef __TraceReplayer_H_
+#define __TraceReplayer_H_
+
+#include <vector>
+
+#include "Arduino.h"
+#include "Button.h"
+#include "CallbackHandler.h"
+#include "TraceRecorder.h"
+
+struct TraceReplayResult
+{
+    // Number of records processed.
+    uint32_t records;
+
+    // Virtual time covered by the trace.
+    uint32_t durationMS;
+
+    // Non-NotPressed states recorded in the trace and produced by the replay.
+    uint32_t recordedStates;
+    uint32_t replayedStates;
+
+    // Positions where the replayed state sequence differs from the recorded one,
+    // including any difference in length. Zero (0) means the replay reproduced the
+    // trace.
+    uint32_t stateMismatches;
+
+    uint32_t callbacksFired;
+
+    uint32_t probes;
+    uint32_t probeTotalMicros;
+    uint16_t probeMaxMicros;
+};
+
+class TraceReplayer
+{
+  public:
+    TraceReplayer();
+
+    /**
+     * @brief   Parse a serialized trace. Previously loaded records are discarded.
+     *
+     * @return  True if the data is a valid trace; otherwise false.
+     **/
+    bool Load(const uint8_t *data, size_t size);
+
+    /**
+     * @brief   Number of records loaded.
+     **/
+    size_t Count() const;
+
+    /**
+     * @brief   Attach a button whose recorded samples will drive its pin.
+     *
+     * @param   button
+     *          Button to drive. Its Id() must match the id used when recording.
+     *
+     * @param   pin
+     *          Pin the button was constructed with.
+     *
+     * @param   polarity
+     *          Polarity the button was constructed with.
+     **/
+    void AttachButton(Button *button, uint32_t pin, ButtonPolarity polarity);
+
+    /**
+     * @brief   Attach a handler that is fired for callback records with the given
+     *          source id. The callback argument points to the recorded uint16_t value.
+     **/
+    void AttachCallback(uint8_t sourceId, CallbackHandler *handler);
+
+    /**
+     * @brief   Replay the loaded trace from virtual time zero (0). The host clock and
+     *          pins are reset first.
+     *
+     * @param   pollIntervalMS
+     *          How often every attached button is polled between records. Should
+     *          match the loop period on the board.
+     **/
+    TraceReplayResult Replay(uint32_t pollIntervalMS = 10);
+
+  private:
+    struct ReplayButton
+    {
+        Button *button;
+        uint32_t pin;
+        ButtonPolarity polarity;
+    };
+
+    struct ReplayCallback
+    {
+        uint8_t sourceId;
+        CallbackHandler *handler;
+    };
+
+    struct StateEvent
+    {
+        uint8_t buttonId;
+        uint8_t state;
+
+        bool operator==(const StateEvent &other) const
+        {
+            return buttonId == other.buttonId && state == other.state;
+        }
+    };
+
+    ReplayButton *FindButton(uint8_t buttonId);
+    void Poll(ReplayButton &button, std::vector<StateEvent> &replayed);
+
+    std::vector<TraceRecord> _records;
+    std::vector<ReplayButton> _buttons;
+    std::vector<ReplayCallback> _callbacks;
+};
+
+#endif //__TraceReplayer_H_
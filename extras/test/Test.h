@@ -0,0 +1,84 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    Test.h
+  * @author  Naigon's Electronic Creations
+  * @brief   Test
+  *          Tiny host test harness. Each module has a suite, Run<Module>Tests, that
+  *          checks behaviour with Test_Check; a failed check prints its location and
+  *          expression and marks the suite failed, but the suite keeps running.
+  *
+  *          Command line:
+  *            --suite NAME    Only run the named suite, ie "EventDispatcher".
+  *            --list          Print the suite names, one per line.
+  *
+  *          Each suite is registered with ctest as its own test.
+  *************************************************************************************
+**/
+
+#ifndef __Test_H_
+#define __Test_H_
+
+#include <cstdint>
+#include <cstdio>
+
+class Test
+{
+  public:
+    Test();
+
+    /**
+     * @brief   Record the result of one check. Use the Test_ macros instead.
+     **/
+    bool Check(bool passed, const char *expression, const char *file, int line);
+
+    /**
+     * @brief   Number of checks that failed.
+     **/
+    uint32_t FailedCount() const;
+
+    /**
+     * @brief   Number of checks made.
+     **/
+    uint32_t CheckCount() const;
+
+  private:
+    uint32_t _checkCount;
+    uint32_t _failedCount;
+};
+
+// Checks that condition is true.
+#define Test_Check(test, condition) \
+    (test).Check((condition), #condition, __FILE__, __LINE__)
+
+// Checks that two integer values are equal, printing both when they are not.
+#define Test_CheckEqual(test, expected, actual) \
+    do \
+    { \
+        long long _expected = (long long)(expected); \
+        long long _actual = (long long)(actual); \
+        if (!(test).Check(_expected == _actual, #expected " == " #actual, __FILE__, __LINE__)) \
+        { \
+            printf("    expected %lld, got %lld\n", _expected, _actual); \
+        } \
+    } while (0)
+
+// Per-module suites. Each lives in its own Test<Module>.cpp.
+void RunAnimationStreamTests(Test &test);
+void RunEventDispatcherTests(Test &test);
+void RunFixedFilterTests(Test &test);
+void RunIndexedPixelBufferTests(Test &test);
+void RunMathUtilsTests(Test &test);
+void RunObjectPoolTests(Test &test);
+void RunParallelRendererTests(Test &test);
+void RunParallelStripEncoderTests(Test &test);
+void RunPixelColorTests(Test &test);
+void RunPixelCompositorTests(Test &test);
+void RunStopwatchTests(Test &test);
+void RunTaskRunnerTests(Test &test);
+void RunTraceReplayerTests(Test &test);
+
+#endif //__Test_H_
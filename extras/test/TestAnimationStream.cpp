@@ -0,0 +1,123 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "AnimationEncoder.h"
+#include "AnimationStream.h"
+#include "Test.h"
+
+namespace
+{
+    const uint16_t pixelCount = 700;
+    const uint16_t frameCount = 40;
+
+    bool Equal(const PixelColor &a, const PixelColor &b)
+    {
+        return a.Red() == b.Red() && a.Green() == b.Green()
+            && a.Blue() == b.Blue() && a.White() == b.White();
+    }
+
+    // Frames that exercise every op: long unchanged spans, long runs, scattered
+    // palette pixels and colors outside the palette, with and without white.
+    std::vector<std::vector<PixelColor>> MakeFrames(const PixelColor *palette, uint8_t paletteSize)
+    {
+        std::vector<std::vector<PixelColor>> frames;
+        std::vector<PixelColor> frame(pixelCount);
+        uint32_t seed = 3;
+
+        for (uint16_t f = 0; f < frameCount; f++)
+        {
+            uint16_t changes = f % 4 == 0 ? 300 : (uint16_t)(f * 3);
+            for (uint16_t c = 0; c < changes; c++)
+            {
+                seed = seed * 1103515245 + 12345;
+                uint16_t at = (uint16_t)((seed >> 8) % pixelCount);
+                uint16_t length = (uint16_t)((seed >> 20) % (f % 5 == 1 ? 90 : 4)) + 1;
+                PixelColor color = (seed & 3) != 0
+                    ? palette[(seed >> 4) % paletteSize]
+                    : PixelColor((uint8_t)(seed >> 3), (uint8_t)(seed >> 11), (uint8_t)f, (seed & 4) ? (uint8_t)c : 0);
+
+                for (uint16_t i = at; i < at + length && i < pixelCount; i++) { frame[i] = color; }
+            }
+
+            frames.push_back(frame);
+        }
+
+        return frames;
+    }
+}
+
+void RunAnimationStreamTests(Test &test)
+{
+    const PixelColor palette[] = { PixelColor(0, 0, 0), PixelColor(0, 80, 255), PixelColor(200, 220, 255, 40) };
+
+    std::vector<std::vector<PixelColor>> frames = MakeFrames(palette, 3);
+    AnimationEncoder encoder(pixelCount, 16, palette, 3);
+    for (uint16_t f = 0; f < frameCount; f++) { encoder.AddFrame(&frames[f][0], f == 25); }
+    const std::vector<uint8_t> &data = encoder.Data();
+    Test_CheckEqual(test, frameCount, encoder.FrameCount());
+
+    AnimationStream stream;
+    Test_CheckEqual(test, 0, stream.Open(&data[0], (uint32_t)data.size()));
+    Test_CheckEqual(test, pixelCount, stream.PixelCount());
+    Test_CheckEqual(test, frameCount, stream.FrameCount());
+    Test_CheckEqual(test, 16, stream.FrameDurationMS());
+
+    // Every frame decodes exactly, twice round, and the stream then ends.
+    std::vector<PixelColor> pixels(pixelCount, PixelColor(1, 2, 3, 4));
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        bool exact = true;
+        for (uint16_t f = 0; f < frameCount; f++)
+        {
+            exact = exact && stream.FrameIndex() == f;
+            exact = exact && stream.DecodeNextFrame(&pixels[0], pixelCount) == 1;
+            for (uint16_t i = 0; i < pixelCount; i++) { exact = exact && Equal(pixels[i], frames[f][i]); }
+        }
+        Test_Check(test, exact);
+        Test_CheckEqual(test, 0, stream.DecodeNextFrame(&pixels[0], pixelCount));
+        stream.Rewind();
+    }
+
+    // A shorter strip gets the leading pixels and nothing past its end.
+    std::vector<PixelColor> shorter(101, PixelColor(9, 9, 9, 9));
+    bool exact = true;
+    for (uint16_t f = 0; f < frameCount; f++)
+    {
+        exact = exact && stream.DecodeNextFrame(&shorter[0], 100) == 1;
+        for (uint16_t i = 0; i < 100; i++) { exact = exact && Equal(shorter[i], frames[f][i]); }
+    }
+    Test_Check(test, exact);
+    Test_Check(test, Equal(shorter[100], PixelColor(9, 9, 9, 9)));
+
+    // The delta frames are much smaller than a full frame.
+    Test_Check(test, data.size() < (uint32_t)frameCount * pixelCount);
+
+    // Truncated streams either fail to open or report invalid data before the last
+    // frame; never a complete, successful playback.
+    bool refused = true;
+    for (uint32_t size = 0; size < data.size(); size++)
+    {
+        AnimationStream truncated;
+        if (truncated.Open(&data[0], size) != 0) { continue; }
+
+        int8_t result = 1;
+        for (uint16_t f = 0; f < frameCount && result == 1; f++)
+        {
+            result = truncated.DecodeNextFrame(&pixels[0], pixelCount);
+        }
+        refused = refused && result == AnimationStream_InvalidData;
+    }
+    Test_Check(test, refused);
+
+    // Bad headers are refused.
+    std::vector<uint8_t> bad(data.begin(), data.end());
+    bad[3] = AnimationStream_Version + 1;
+    Test_CheckEqual(test, AnimationStream_InvalidData, stream.Open(&bad[0], (uint32_t)bad.size()));
+    bad[3] = AnimationStream_Version;
+    bad[0] = 'X';
+    Test_CheckEqual(test, AnimationStream_InvalidData, stream.Open(&bad[0], (uint32_t)bad.size()));
+    Test_CheckEqual(test, AnimationStream_InvalidData, stream.Open(&data[0], AnimationStream_HeaderSize - 1));
+}
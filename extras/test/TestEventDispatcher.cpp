@@ -0,0 +1,184 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "EventDispatcher.h"
+#include "Test.h"
+
+namespace
+{
+    EventDispatcher *dispatcher;
+
+    // Each callback appends (event * 100 + payload) so order and payload are checked
+    // together; an empty payload records as payload 0.
+    std::vector<int> calls;
+
+    int PayloadOf(void *arg)
+    {
+        return arg != nullptr ? *static_cast<uint8_t *>(arg) : 0;
+    }
+
+    void OnEvent1(void *arg) { calls.push_back(100 + PayloadOf(arg)); }
+    void OnEvent2(void *arg) { calls.push_back(200 + PayloadOf(arg)); }
+    void OnEvent3(void *arg) { calls.push_back(300 + PayloadOf(arg)); }
+
+    void OnEvent1RepostsEvent2(void *arg)
+    {
+        calls.push_back(100 + PayloadOf(arg));
+        uint8_t payload = 9;
+        dispatcher->Post(2, &payload, 1);
+    }
+
+    void OnEvent2RepostsEvent1(void *arg)
+    {
+        calls.push_back(200 + PayloadOf(arg));
+        uint8_t payload = 7;
+        dispatcher->Post(1, &payload, 1);
+    }
+
+    void OnEventRepostsItself(void *arg)
+    {
+        calls.push_back(100 + PayloadOf(arg));
+        dispatcher->Post(1);
+    }
+
+    bool payloadAligned;
+    uint64_t payloadValue;
+
+    void OnWidePayload(void *arg)
+    {
+        payloadAligned = (uintptr_t)arg % alignof(uint64_t) == 0;
+        payloadValue = *static_cast<uint64_t *>(arg);
+    }
+
+    bool Matches(const std::vector<int> &expected)
+    {
+        bool matches = calls == expected;
+        calls.clear();
+        return matches;
+    }
+}
+
+void RunEventDispatcherTests(Test &test)
+{
+    uint8_t one = 1;
+    uint8_t two = 2;
+
+    // Priority order, then latest payload wins.
+    {
+        StaticEventDispatcher<4> events;
+        dispatcher = &events;
+        events.RegisterEventCallback(1, OnEvent1, PriorityCosmetic);
+        events.RegisterEventCallback(2, OnEvent2, PriorityCritical);
+        events.RegisterEventCallback(3, OnEvent3);
+
+        events.Post(1, &one, 1);
+        events.Post(3);
+        events.Post(2, &one, 1);
+        events.Post(2, &two, 1);
+        Test_Check(test, events.HasPending());
+        Test_CheckEqual(test, 3, events.Dispatch());
+        Test_Check(test, Matches({ 202, 300, 101 }));
+        Test_CheckEqual(test, 1, events.CoalescedCount());
+        Test_Check(test, !events.HasPending());
+        Test_CheckEqual(test, 0, events.Dispatch());
+
+        Test_Check(test, !events.Post(4));
+        Test_Check(test, !events.Post(1, &one, EventDispatcher_MaxPayloadSize + 1));
+        Test_CheckEqual(test,
+            EventDispatcher_UnableToRegister,
+            events.RegisterEventCallback(1, OnEvent2, PriorityHigh));
+    }
+
+    // A same-level re-post of an event that has not run yet merges into this run, so
+    // it is delivered once, with the latest payload.
+    {
+        StaticEventDispatcher<4> events;
+        dispatcher = &events;
+        events.RegisterEventCallback(1, OnEvent1RepostsEvent2, PriorityNormal);
+        events.RegisterEventCallback(2, OnEvent2, PriorityNormal);
+
+        events.Post(2, &one, 1);
+        events.Post(1);
+        Test_CheckEqual(test, 2, events.Dispatch());
+        Test_Check(test, Matches({ 100, 209 }));
+        Test_Check(test, !events.HasPending());
+        Test_CheckEqual(test, 0, events.Dispatch());
+        Test_Check(test, Matches({}));
+    }
+
+    // A re-post of an event that already ran this call is delivered on the next one.
+    {
+        StaticEventDispatcher<4> events;
+        dispatcher = &events;
+        events.RegisterEventCallback(1, OnEvent1, PriorityNormal);
+        events.RegisterEventCallback(2, OnEvent2RepostsEvent1, PriorityNormal);
+
+        events.Post(1, &one, 1);
+        events.Post(2);
+        Test_CheckEqual(test, 2, events.Dispatch());
+        Test_Check(test, Matches({ 101, 200 }));
+        Test_CheckEqual(test, 1, events.Dispatch());
+        Test_Check(test, Matches({ 107 }));
+    }
+
+    // An event that re-posts itself runs once per call rather than looping.
+    {
+        StaticEventDispatcher<4> events;
+        dispatcher = &events;
+        events.RegisterEventCallback(1, OnEventRepostsItself, PriorityHigh);
+
+        events.Post(1);
+        Test_CheckEqual(test, 1, events.Dispatch());
+        Test_CheckEqual(test, 1, events.Dispatch());
+        Test_Check(test, events.HasPending());
+        calls.clear();
+    }
+
+    // Callbacks may read the payload as their own type.
+    {
+        StaticEventDispatcher<4> events;
+        events.RegisterEventCallback(1, OnWidePayload, PriorityNormal);
+
+        uint64_t value = 0x0123456789ABCDEFull;
+        events.Post(1, &value, sizeof(value));
+        payloadAligned = false;
+        events.Dispatch();
+        Test_Check(test, payloadAligned);
+        Test_Check(test, payloadValue == value);
+    }
+
+    // Unregistering discards pending posts, by token or by EventId.
+    {
+        StaticEventDispatcher<4> events;
+        dispatcher = &events;
+        int8_t token = events.RegisterEventCallback(1, OnEvent1, PriorityNormal);
+        events.RegisterEventCallback(2, OnEvent2);
+
+        events.Post(1);
+        events.Post(2);
+        events.UnregisterEventCallback(token);
+        events.UnregisterEvent(2);
+        Test_Check(test, !events.HasPending());
+        Test_CheckEqual(test, 0, events.Dispatch());
+        Test_Check(test, !events.Post(2));
+
+        // The slots can be registered again.
+        Test_Check(test, events.RegisterEventCallback(2, OnEvent2, PriorityHigh) >= 0);
+        events.UnregisterEvent(5);
+    }
+
+    // Only as many events as there are slots can be registered.
+    {
+        StaticEventDispatcher<2> events;
+        Test_CheckEqual(test, 0, events.RegisterEventCallback(1, OnEvent1, PriorityNormal));
+        Test_CheckEqual(test, 1, events.RegisterEventCallback(2, OnEvent2, PriorityNormal));
+        Test_CheckEqual(test,
+            EventDispatcher_UnableToRegister,
+            events.RegisterEventCallback(3, OnEvent3, PriorityNormal));
+        events.UnregisterEventCallback(2);
+        Test_Check(test, !events.HasPending());
+    }
+}
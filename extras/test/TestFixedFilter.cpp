@@ -0,0 +1,248 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <math.h>
+
+#include "FixedFilter.h"
+#include "MathUtils.h"
+#include "MotionDetector.h"
+#include "Test.h"
+
+namespace
+{
+    uint8_t callbackFlags;
+    uint16_t callbackCount;
+
+    void OnMotion(void *arg)
+    {
+        callbackFlags |= *static_cast<uint8_t *>(arg);
+        callbackCount++;
+    }
+
+    void TestBiquad(Test &test)
+    {
+        BiquadCoefficients lowPass[2] =
+        {
+            BiquadCascade::LowPass(10, 1000),
+            BiquadCascade::LowPass(10, 1000),
+        };
+        BiquadState states[2];
+
+        // A step settles exactly at its level: unity DC gain, no residual error.
+        int16_t in[1000];
+        int16_t out[1000];
+        for (uint16_t i = 0; i < 1000; i++) { in[i] = 10000; }
+        BiquadCascade cascade(lowPass, states, 2);
+        cascade.ProcessBatch(in, out, 1000);
+        Test_CheckEqual(test, 10000, out[999]);
+        Test_Check(test, out[5] < 1000);
+
+        // The batch and per-sample paths give identical output.
+        cascade.Reset();
+        bool same = true;
+        for (uint16_t i = 0; i < 1000; i++)
+        {
+            int16_t sample = (int16_t)(8000 * sin(i * 0.05) + ((i * 7919) % 2001) - 1000);
+            in[i] = sample;
+        }
+        cascade.ProcessBatch(in, out, 1000);
+        cascade.Reset();
+        for (uint16_t i = 0; i < 1000; i++) { same = same && cascade.Process(in[i]) == out[i]; }
+        Test_Check(test, same);
+
+        // A high-pass removes the offset and keeps the tone.
+        BiquadCoefficients highPass = BiquadCascade::HighPass(5, 1000);
+        BiquadState highState;
+        BiquadCascade high(&highPass, &highState, 1);
+        int16_t peak = 0;
+        int32_t sum = 0;
+        for (uint16_t i = 0; i < 2000; i++)
+        {
+            int16_t value = high.Process((int16_t)(12000 + 3000 * sin(2 * M_PI * 100 * i / 1000.0)));
+            if (i < 1900) { continue; }
+            if (abs(value) > peak) { peak = (int16_t)abs(value); }
+            sum += value;
+        }
+        Test_Check(test, peak > 2800 && peak < 3200);
+        Test_Check(test, abs(sum / 100) < 50);
+
+        // A strided batch filters one channel and leaves the others alone.
+        int16_t xyz[30];
+        for (uint8_t i = 0; i < 30; i++) { xyz[i] = i % 3 == 1 ? 10000 : (int16_t)i; }
+        cascade.Reset();
+        cascade.ProcessBatch(xyz + 1, xyz + 1, 10, 3);
+        cascade.Reset();
+        same = true;
+        for (uint8_t i = 0; i < 10; i++)
+        {
+            same = same && xyz[3 * i] == 3 * i && xyz[3 * i + 2] == 3 * i + 2;
+            same = same && xyz[3 * i + 1] == cascade.Process(10000);
+        }
+        Test_Check(test, same);
+    }
+
+    void TestRunningStats(Test &test)
+    {
+        int16_t window[8];
+        RunningStats stats(window, 8);
+        Test_CheckEqual(test, 0, stats.Count());
+        Test_CheckEqual(test, 0, stats.Mean());
+        Test_CheckEqual(test, 0u, stats.Variance());
+
+        int16_t values[40];
+        for (uint8_t i = 0; i < 40; i++)
+        {
+            values[i] = (int16_t)((((i * 7919) % 200) - 100) * 300);
+        }
+
+        bool matches = true;
+        for (uint8_t i = 0; i < 40; i++)
+        {
+            stats.Add(values[i]);
+
+            // Brute force over the last (up to) 8 samples.
+            uint8_t count = i + 1 < 8 ? i + 1 : 8;
+            double mean = 0;
+            for (uint8_t j = i + 1 - count; j <= i; j++) { mean += values[j]; }
+            mean /= count;
+            double variance = 0;
+            for (uint8_t j = i + 1 - count; j <= i; j++)
+            {
+                variance += (values[j] - mean) * (values[j] - mean);
+            }
+            variance /= count;
+
+            matches = matches
+                && stats.Count() == count
+                && stats.Mean() == (int16_t)mean
+                && fabs(stats.Variance() - variance) <= variance * 1e-6 + 1;
+        }
+        Test_Check(test, matches);
+
+        // Full-scale samples do not overflow the sums.
+        stats.Reset();
+        for (uint8_t i = 0; i < 8; i++) { stats.Add(i % 2 == 0 ? 32767 : -32768); }
+        Test_CheckEqual(test, 0, stats.Mean());
+        Test_Check(test, stats.Variance() >= 1073709056u && stats.Variance() <= 1073774592u);
+
+        // AddBatch with a stride matches Add.
+        int16_t xyz[24];
+        for (uint8_t i = 0; i < 24; i++) { xyz[i] = (int16_t)(i * 100); }
+        stats.Reset();
+        stats.AddBatch(xyz + 2, 8, 3);
+        Test_CheckEqual(test, (int16_t)((200 + 2300) / 2), stats.Mean());
+    }
+
+    void TestMagnitude(Test &test)
+    {
+        // Checked against the documented bounds, allowing 1 below for truncation.
+        bool within2 = true;
+        bool within3 = true;
+        uint32_t seed = 12345;
+        for (uint32_t i = 0; i < 200000; i++)
+        {
+            int16_t v[3];
+            for (uint8_t j = 0; j < 3; j++)
+            {
+                seed = seed * 1103515245 + 12345;
+                v[j] = (int16_t)((int16_t)(seed >> 16) / (1 << (i % 8)));
+            }
+
+            double exact2 = sqrt((double)v[0] * v[0] + (double)v[1] * v[1]);
+            double estimate2 = fixedMagnitude2(v[0], v[1]);
+            within2 = within2 && estimate2 + 1 >= exact2 * 0.9597 && estimate2 <= exact2 * 1.0403;
+
+            double exact3 = sqrt((double)v[0] * v[0] + (double)v[1] * v[1] + (double)v[2] * v[2]);
+            double estimate3 = fixedMagnitude3(v[0], v[1], v[2]);
+            within3 = within3 && estimate3 + 1 >= exact3 * 0.9375 && estimate3 <= exact3 * 1.06;
+        }
+        Test_Check(test, within2);
+        Test_Check(test, within3);
+
+        // The worst case is along an axis, and extremes do not wrap.
+        Test_CheckEqual(test, 30000, fixedMagnitude3(-32000, 0, 0));
+        Test_CheckEqual(test, 32768, fixedMagnitude2(-32768, 0));
+        Test_CheckEqual(test, 53248, fixedMagnitude3(-32768, -32768, -32768));
+
+        int16_t xyz[6] = { 3, 4, 0, -32000, 0, 0 };
+        uint16_t magnitudes[2];
+        fixedMagnitude3Batch(xyz, magnitudes, 2);
+        Test_CheckEqual(test, fixedMagnitude3(3, 4, 0), magnitudes[0]);
+        Test_CheckEqual(test, 30000, magnitudes[1]);
+    }
+
+    void TestMotionDetector(Test &test)
+    {
+        // 1000 samples at rest with the blade up; a swing from 300 to 600 and a
+        // clash at 700, with the sensor ringing for a few samples after it.
+        static int16_t accel[3 * 1000];
+        static int16_t gyro[3 * 1000];
+        for (uint16_t i = 0; i < 1000; i++)
+        {
+            accel[3 * i] = i >= 700 && i < 705 ? (i % 2 == 0 ? 12000 : -12000) : 0;
+            accel[3 * i + 1] = 0;
+            accel[3 * i + 2] = 4096;
+            gyro[3 * i] = i >= 300 && i < 600 ? 8000 : 100;
+            gyro[3 * i + 1] = 0;
+            gyro[3 * i + 2] = 0;
+        }
+
+        MotionDetector detector(BiquadCascade::LowPass(20, 1000), 4000, 6000, 50);
+        detector.RegisterCallback(OnMotion);
+        callbackFlags = 0;
+        callbackCount = 0;
+
+        uint16_t swingStart = 0;
+        uint16_t clashStart = 0;
+        uint8_t swings = 0;
+        uint8_t clashes = 0;
+        bool swingingAt500 = false;
+        for (uint16_t i = 0; i < 1000; i++)
+        {
+            uint8_t events = detector.Process(&accel[3 * i], &gyro[3 * i]);
+            if (events & MotionDetector_Swing) { swings++; swingStart = i; }
+            if (events & MotionDetector_Clash) { clashes++; clashStart = i; }
+            if (i == 500) { swingingAt500 = detector.IsSwinging(); }
+        }
+
+        Test_CheckEqual(test, 1, swings);
+        Test_Check(test, swingStart > 300 && swingStart < 330);
+        Test_Check(test, swingingAt500);
+        Test_Check(test, !detector.IsSwinging());
+        Test_Check(test, detector.SwingSpeed() < 200);
+
+        // The ringing after the clash is held off.
+        Test_CheckEqual(test, 1, clashes);
+        Test_CheckEqual(test, 700, clashStart);
+        Test_CheckEqual(test, 2, callbackCount);
+        Test_CheckEqual(test, MotionDetector_Swing | MotionDetector_Clash, callbackFlags);
+
+        // A batch reports the same events as single samples, once per burst.
+        detector.Reset();
+        callbackFlags = 0;
+        callbackCount = 0;
+        uint8_t all = 0;
+        for (uint16_t i = 0; i < 1000; i += 100)
+        {
+            all |= detector.ProcessBatch(&accel[3 * i], &gyro[3 * i], 100);
+        }
+        Test_CheckEqual(test, MotionDetector_Swing | MotionDetector_Clash, all);
+        Test_CheckEqual(test, 2, callbackCount);
+
+        // Raising the thresholds suppresses both.
+        detector.Reset();
+        detector.SetThresholds(20000, 30000);
+        detector.UnregisterCallback();
+        Test_CheckEqual(test, 0, detector.ProcessBatch(accel, gyro, 1000));
+        Test_CheckEqual(test, 2, callbackCount);
+    }
+}
+
+void RunFixedFilterTests(Test &test)
+{
+    TestBiquad(test);
+    TestRunningStats(test);
+    TestMagnitude(test);
+    TestMotionDetector(test);
+}
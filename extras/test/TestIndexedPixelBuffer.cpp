@@ -0,0 +1,94 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "IndexedPixelBuffer.h"
+#include "Test.h"
+
+void RunIndexedPixelBufferTests(Test &test)
+{
+    const uint16_t size = 37;
+    const uint8_t bitDepths[] = { 4, 8 };
+    const PixelCorrection correction = { WhiteReplace, 256, 200, 300, 128 };
+
+    // 12 colors, so indices 12 to 15 are past the palette and read as black.
+    PixelColor palette[12];
+    for (uint8_t i = 0; i < 12; i++)
+    {
+        palette[i] = PixelColor((uint8_t)(i * 20), (uint8_t)(255 - i * 20), (uint8_t)(i * 7 + 30), (uint8_t)i);
+    }
+
+    for (uint8_t bits : bitDepths)
+    {
+        std::vector<uint8_t> storage(IndexedPixelBuffer::StorageSize(size, bits));
+        IndexedPixelBuffer buffer(&storage[0], size, bits, palette, 12);
+        for (uint16_t i = 0; i < size; i++) { buffer.SetIndex(i, (uint8_t)((i * 5) % 16)); }
+
+        for (uint8_t corrected = 0; corrected < 2; corrected++)
+        {
+            const PixelCorrection *applied = corrected ? &correction : nullptr;
+
+            // The whole-strip Pack matches PackedValue of each pixel's color.
+            uint32_t whole[size];
+            uint32_t lookup[size];
+            uint32_t packedPalette[256];
+            buffer.Pack(whole, PixelType::SK6812_RGBW, nullptr, applied);
+            buffer.Pack(lookup, PixelType::SK6812_RGBW, packedPalette, applied);
+
+            bool matches = true;
+            for (uint16_t i = 0; i < size; i++)
+            {
+                PixelColor color = buffer.ColorAt(i);
+                uint32_t expected = applied != nullptr
+                    ? color.PackedValue(PixelType::SK6812_RGBW, correction)
+                    : color.PackedValue(PixelType::SK6812_RGBW);
+                matches = matches && whole[i] == expected && lookup[i] == expected;
+            }
+            Test_Check(test, matches);
+
+            // Every range, odd and even edges alike, matches the same slice of it, and
+            // nothing is written past it, even for an empty range.
+            matches = true;
+            for (uint16_t start = 0; start < size; start++)
+            {
+                for (uint16_t count = 0; start + count <= size; count++)
+                {
+                    uint32_t direct[size + 1];
+                    uint32_t ranged[size + 1];
+                    direct[count] = 0xDEADBEEF;
+                    ranged[count] = 0xDEADBEEF;
+                    buffer.Pack(direct, start, count, PixelType::SK6812_RGBW, nullptr, applied);
+                    buffer.Pack(ranged, start, count, PixelType::SK6812_RGBW, packedPalette, applied);
+
+                    for (uint16_t i = 0; i < count; i++)
+                    {
+                        matches = matches && direct[i] == whole[start + i] && ranged[i] == whole[start + i];
+                    }
+                    matches = matches && direct[count] == 0xDEADBEEF && ranged[count] == 0xDEADBEEF;
+                }
+            }
+            Test_Check(test, matches);
+        }
+
+        // Streaming through a chunk buffer reproduces the strip, and a range past the
+        // last pixel is cut short.
+        uint32_t whole[size];
+        uint32_t streamed[size + 16];
+        buffer.Pack(whole, PixelType::WS2812b);
+        for (uint16_t i = 0; i < size + 16; i++) { streamed[i] = 0xDEADBEEF; }
+        for (uint16_t i = 0; i < size; i += 16)
+        {
+            buffer.Pack(&streamed[i], i, 16, PixelType::WS2812b);
+        }
+
+        bool matches = true;
+        for (uint16_t i = 0; i < size; i++) { matches = matches && streamed[i] == whole[i]; }
+        for (uint16_t i = size; i < size + 16; i++) { matches = matches && streamed[i] == 0xDEADBEEF; }
+        Test_Check(test, matches);
+
+        buffer.Pack(streamed, size, 4, PixelType::WS2812b);
+        Test_CheckEqual(test, 0xDEADBEEFu, streamed[size]);
+    }
+}
@@ -0,0 +1,101 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <cstring>
+
+#include "Test.h"
+
+namespace
+{
+    struct Suite
+    {
+        const char *name;
+        void (*run)(Test &test);
+    };
+
+    const Suite suites[] =
+    {
+        { "AnimationStream", RunAnimationStreamTests },
+        { "EventDispatcher", RunEventDispatcherTests },
+        { "FixedFilter", RunFixedFilterTests },
+        { "IndexedPixelBuffer", RunIndexedPixelBufferTests },
+        { "MathUtils", RunMathUtilsTests },
+        { "ObjectPool", RunObjectPoolTests },
+        { "ParallelRenderer", RunParallelRendererTests },
+        { "ParallelStripEncoder", RunParallelStripEncoderTests },
+        { "PixelColor", RunPixelColorTests },
+        { "PixelCompositor", RunPixelCompositorTests },
+        { "Stopwatch", RunStopwatchTests },
+        { "TaskRunner", RunTaskRunnerTests },
+        { "TraceReplayer", RunTraceReplayerTests },
+    };
+}
+
+Test::Test()
+    : _checkCount(0)
+    , _failedCount(0)
+{
+}
+
+bool Test::Check(bool passed, const char *expression, const char *file, int line)
+{
+    _checkCount++;
+    if (!passed)
+    {
+        _failedCount++;
+        printf("  FAILED %s:%d: %s\n", file, line, expression);
+    }
+
+    return passed;
+}
+
+uint32_t Test::FailedCount() const
+{
+    return _failedCount;
+}
+
+uint32_t Test::CheckCount() const
+{
+    return _checkCount;
+}
+
+int main(int argc, char **argv)
+{
+    const char *only = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--suite") == 0 && i + 1 < argc)
+        {
+            only = argv[++i];
+        }
+        else if (strcmp(argv[i], "--list") == 0)
+        {
+            for (const Suite &suite : suites) { printf("%s\n", suite.name); }
+            return 0;
+        }
+    }
+
+    int failedSuites = 0;
+    int ranSuites = 0;
+    for (const Suite &suite : suites)
+    {
+        if (only != nullptr && strcmp(only, suite.name) != 0) { continue; }
+
+        Test test;
+        suite.run(test);
+        ranSuites++;
+
+        bool passed = test.FailedCount() == 0;
+        if (!passed) { failedSuites++; }
+        printf("%-24s %s (%u checks)\n", suite.name, passed ? "ok" : "FAILED", test.CheckCount());
+    }
+
+    if (ranSuites == 0)
+    {
+        printf("No suite named %s\n", only != nullptr ? only : "");
+        return 1;
+    }
+
+    return failedSuites == 0 ? 0 : 1;
+}
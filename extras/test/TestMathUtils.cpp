@@ -0,0 +1,155 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <math.h>
+
+#include "MathUtils.h"
+#include "Test.h"
+
+namespace
+{
+    // Largest distance between the fixed point spectrum and a double DFT of the same
+    // samples, scaled the same way (divided by n, in input units).
+    double SpectrumError(const double *x, const int16_t *spectrum, uint16_t n)
+    {
+        double worst = 0;
+        for (uint16_t k = 0; k <= n / 2; k++)
+        {
+            double re = 0;
+            double im = 0;
+            for (uint16_t i = 0; i < n; i++)
+            {
+                re += x[i] * cos(2 * M_PI * k * i / n);
+                im -= x[i] * sin(2 * M_PI * k * i / n);
+            }
+            re /= n;
+            im /= n;
+
+            double fixedRe = k == 0 ? spectrum[0] : k == n / 2 ? spectrum[1] : spectrum[2 * k];
+            double fixedIm = k == 0 || k == n / 2 ? 0 : spectrum[2 * k + 1];
+            worst = fmax(worst, hypot(fixedRe - re, fixedIm - im));
+        }
+
+        return worst;
+    }
+
+    void TestFft(Test &test)
+    {
+        const uint16_t sizes[] = { 64, 128, 256 };
+        for (uint16_t n : sizes)
+        {
+            // Two tones, an offset and some noise.
+            double x[256];
+            int16_t data[256];
+            for (uint16_t i = 0; i < n; i++)
+            {
+                double value = 0.4 * sin(2 * M_PI * 5 * i / n) + 0.3 * cos(2 * M_PI * (n / 4 - 3) * i / n)
+                    + 0.1 + 0.05 * (((i * 37) % 17) - 8) / 8.0;
+                data[i] = (int16_t)lround(value * 32767);
+                x[i] = data[i];
+            }
+            Test_CheckEqual(test, 0, fixedRealFft(data, n));
+            Test_Check(test, SpectrumError(x, data, n) < 8);
+
+            // A full-scale square wave does not overflow.
+            for (uint16_t i = 0; i < n; i++)
+            {
+                data[i] = (i / 4) % 2 == 0 ? 32767 : -32768;
+                x[i] = data[i];
+            }
+            fixedRealFft(data, n);
+            Test_Check(test, SpectrumError(x, data, n) < 8);
+
+            // Magnitudes follow the spectrum, in place, within fixedMagnitude2's 4.03%
+            // plus the FFT's own rounding. A sine of amplitude a gives a bin of a / 2.
+            for (uint16_t i = 0; i < n; i++)
+            {
+                data[i] = (int16_t)lround(16000 * sin(2 * M_PI * 7 * i / n) + 4000);
+            }
+            fixedRealFft(data, n);
+            fixedFftMagnitudes(data, n, (uint16_t *)data);
+            uint16_t *magnitudes = (uint16_t *)data;
+            Test_Check(test, abs(magnitudes[0] - 4000) <= 8);
+            Test_Check(test, abs(magnitudes[7] - 8000) <= 8000 * 0.0403 + 8);
+            Test_Check(test, magnitudes[6] < 16 && magnitudes[8] < 16);
+        }
+
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedRealFft(nullptr, 32));
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedRealFft(nullptr, 100));
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedRealFft(nullptr, 512));
+    }
+
+    void TestWindow(Test &test)
+    {
+        int16_t samples[64];
+        for (uint8_t i = 0; i < 64; i++) { samples[i] = 32767; }
+        Test_CheckEqual(test, 0, fixedWindowHann(samples, 64));
+        Test_CheckEqual(test, 0, samples[0]);
+        Test_CheckEqual(test, 32766, samples[32]);
+
+        bool matches = true;
+        for (uint8_t i = 1; i < 64; i++)
+        {
+            double expected = 32767 * 0.5 * (1 - cos(2 * M_PI * i / 64));
+            matches = matches && fabs(samples[i] - expected) <= 2;
+            matches = matches && samples[i] == samples[64 - i];
+        }
+        Test_Check(test, matches);
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedWindowHann(samples, 48));
+    }
+
+    void TestBands(Test &test)
+    {
+        // A tone lands in one band, and moving it up never moves it to a lower band.
+        const uint16_t n = 256;
+        int16_t data[n];
+        uint32_t bands[8];
+        int8_t previous = 0;
+        bool monotonic = true;
+        bool dominant = true;
+        for (uint16_t bin = 1; bin < n / 2; bin++)
+        {
+            for (uint16_t i = 0; i < n; i++)
+            {
+                data[i] = (int16_t)lround(20000 * cos(2 * M_PI * bin * i / n) + 5000);
+            }
+            fixedRealFft(data, n);
+            fixedFftMagnitudes(data, n, (uint16_t *)data);
+            Test_CheckEqual(test, 0, fixedBandEnergies((uint16_t *)data, n / 2, bands, 8));
+
+            int8_t loudest = 0;
+            uint32_t total = 0;
+            for (int8_t b = 0; b < 8; b++)
+            {
+                total += bands[b];
+                if (bands[b] > bands[loudest]) { loudest = b; }
+            }
+            monotonic = monotonic && loudest >= previous;
+            dominant = dominant && bands[loudest] * 10 > total * 9;
+            previous = loudest;
+        }
+        Test_Check(test, monotonic);
+        Test_Check(test, dominant);
+        Test_CheckEqual(test, 7, previous);
+
+        // DC is skipped, and each band is the mean power of its bins.
+        uint16_t magnitudes[8] = { 60000, 16, 32, 32, 64, 64, 64, 64 };
+        uint32_t three[3];
+        Test_CheckEqual(test, 0, fixedBandEnergies(magnitudes, 8, three, 3));
+        Test_CheckEqual(test, 1u, three[0]);
+        Test_CheckEqual(test, 4u, three[1]);
+        Test_CheckEqual(test, 16u, three[2]);
+
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedBandEnergies(magnitudes, 8, three, 0));
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedBandEnergies(magnitudes, 8, bands, 8));
+        Test_CheckEqual(test, MathUtils_InvalidSize, fixedBandEnergies(magnitudes, 6, three, 3));
+    }
+}
+
+void RunMathUtilsTests(Test &test)
+{
+    TestFft(test);
+    TestWindow(test);
+    TestBands(test);
+}
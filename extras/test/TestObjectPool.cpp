@@ -0,0 +1,221 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "EventDispatcher.h"
+#include "FrameArena.h"
+#include "ObjectPool.h"
+#include "Test.h"
+
+namespace
+{
+    struct Payload
+    {
+        uint32_t value;
+        uint16_t extra;
+    };
+
+    EventDispatcher *dispatcher;
+    StaticObjectPool<Payload, 4> *pool;
+    std::vector<uint32_t> received;
+
+    // Records the payload value, or 0 for nullptr, and frees the block it now owns.
+    void OnOwned(void *arg)
+    {
+        received.push_back(arg != nullptr ? static_cast<Payload *>(arg)->value : 0);
+        pool->Free(arg);
+    }
+
+    void OnPostOwned(void *)
+    {
+        Payload *payload = pool->Allocate();
+        payload->value = 42;
+        dispatcher->PostOwned(2, *pool, payload);
+    }
+
+    void OnOwnedReposts(void *arg)
+    {
+        received.push_back(static_cast<Payload *>(arg)->value);
+        static_cast<Payload *>(arg)->value++;
+        dispatcher->PostOwned(2, *pool, arg);
+    }
+
+    void TestPool(Test &test)
+    {
+        StaticObjectPool<Payload, 4> payloads;
+        Test_CheckEqual(test, 4, payloads.Capacity());
+        Test_Check(test, payloads.BlockSize() >= sizeof(Payload));
+        Test_CheckEqual(test, 0, payloads.BlockSize() % alignof(Payload));
+
+        Payload *blocks[4];
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            blocks[i] = payloads.Allocate();
+            Test_Check(test, blocks[i] != nullptr);
+            Test_Check(test, payloads.Owns(blocks[i]));
+            Test_CheckEqual(test, 0u, (uintptr_t)blocks[i] % alignof(Payload));
+            blocks[i]->value = i;
+        }
+
+        Test_Check(test, payloads.Allocate() == nullptr);
+        Test_CheckEqual(test, 1, payloads.FailedCount());
+        Test_CheckEqual(test, 4, payloads.InUse());
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            Test_CheckEqual(test, (uint32_t)i, blocks[i]->value);
+        }
+
+        // Pointers that are not the start of a block are refused.
+        uint8_t *inside = (uint8_t *)blocks[1] + 1;
+        Payload outside;
+        Test_Check(test, !payloads.Free(inside));
+        Test_Check(test, !payloads.Free(&outside));
+        Test_Check(test, !payloads.Free(nullptr));
+
+        // The most recently freed block is reused first.
+        Test_Check(test, payloads.Free(blocks[2]));
+        Test_Check(test, payloads.Allocate() == blocks[2]);
+
+        payloads.Free(blocks[0]);
+        payloads.Free(blocks[3]);
+        Test_CheckEqual(test, 2, payloads.InUse());
+        Test_CheckEqual(test, 4, payloads.HighWaterMark());
+
+        payloads.ResetStatistics();
+        Test_CheckEqual(test, 2, payloads.HighWaterMark());
+        Test_CheckEqual(test, 0, payloads.FailedCount());
+
+        payloads.Reset();
+        Test_CheckEqual(test, 0, payloads.InUse());
+        for (uint8_t i = 0; i < 4; i++) { Test_Check(test, payloads.Allocate() != nullptr); }
+        Test_Check(test, payloads.Allocate() == nullptr);
+    }
+
+    void TestArena(Test &test)
+    {
+        alignas(8) uint8_t storage[64];
+        FrameArena arena(storage, sizeof(storage));
+
+        uint8_t *a = (uint8_t *)arena.Allocate(3, 1);
+        uint32_t *b = (uint32_t *)arena.Allocate(sizeof(uint32_t), alignof(uint32_t));
+        Test_Check(test, a == storage);
+        Test_CheckEqual(test, 0u, (uintptr_t)b % alignof(uint32_t));
+        Test_Check(test, (uint8_t *)b >= a + 3);
+        Test_CheckEqual(test, 8, arena.Used());
+
+        Test_Check(test, arena.Allocate(57, 1) == nullptr);
+        Test_CheckEqual(test, 1, arena.FailedCount());
+        Test_Check(test, arena.Allocate(56, 1) != nullptr);
+        Test_CheckEqual(test, 64, arena.Used());
+
+        arena.Reset();
+        Test_CheckEqual(test, 0, arena.Used());
+        Test_CheckEqual(test, 64, arena.HighWaterMark());
+        Test_Check(test, arena.Allocate(8) == storage);
+
+        arena.ResetStatistics();
+        Test_CheckEqual(test, 8, arena.HighWaterMark());
+        Test_CheckEqual(test, 0, arena.FailedCount());
+    }
+
+    void TestOwnedPayloads(Test &test)
+    {
+        StaticObjectPool<Payload, 4> payloads;
+        pool = &payloads;
+
+        // A same-level PostOwned made by an earlier callback is delivered once, with
+        // its block, and the slot is empty afterwards.
+        {
+            StaticEventDispatcher<4> events;
+            dispatcher = &events;
+            events.RegisterEventCallback(1, OnPostOwned, PriorityNormal);
+            events.RegisterEventCallback(2, OnOwned, PriorityNormal);
+
+            Payload *first = payloads.Allocate();
+            first->value = 7;
+            events.PostOwned(2, payloads, first);
+            events.Post(1);
+
+            Test_CheckEqual(test, 2, events.Dispatch());
+            Test_CheckEqual(test, 1u, received.size());
+            Test_CheckEqual(test, 42u, received[0]);
+            Test_CheckEqual(test, 0, events.Dispatch());
+            Test_CheckEqual(test, 1u, received.size());
+
+            // The block that was replaced before it ran went back to the pool.
+            Test_CheckEqual(test, 0, payloads.InUse());
+            received.clear();
+        }
+
+        // Copied and owned posts can replace each other; whichever is latest is
+        // delivered, and a replaced block is freed.
+        {
+            StaticEventDispatcher<4> events;
+            dispatcher = &events;
+            events.RegisterEventCallback(2, OnOwned, PriorityNormal);
+
+            Payload copied = { 5, 0 };
+            events.PostOwned(2, payloads, payloads.Allocate());
+            events.Post(2, &copied, sizeof(copied));
+            Test_CheckEqual(test, 0, payloads.InUse());
+            events.Dispatch();
+
+            Payload *owned = payloads.Allocate();
+            owned->value = 6;
+            events.Post(2, &copied, sizeof(copied));
+            events.PostOwned(2, payloads, owned);
+            events.Dispatch();
+
+            Test_CheckEqual(test, 2u, received.size());
+            Test_CheckEqual(test, 5u, received[0]);
+            Test_CheckEqual(test, 6u, received[1]);
+            Test_CheckEqual(test, 0, payloads.InUse());
+            received.clear();
+        }
+
+        // A callback may post the block it was given again, and re-posting a pending
+        // block does not free it.
+        {
+            StaticEventDispatcher<4> events;
+            dispatcher = &events;
+            events.RegisterEventCallback(2, OnOwnedReposts, PriorityNormal);
+
+            Payload *block = payloads.Allocate();
+            block->value = 1;
+            events.PostOwned(2, payloads, block);
+            events.PostOwned(2, payloads, block);
+            Test_CheckEqual(test, 1, payloads.InUse());
+
+            events.Dispatch();
+            events.Dispatch();
+            Test_CheckEqual(test, 2u, received.size());
+            Test_CheckEqual(test, 2u, received[1]);
+
+            // Unregistering frees the block still pending.
+            events.UnregisterEvent(2);
+            Test_CheckEqual(test, 0, payloads.InUse());
+            received.clear();
+        }
+
+        // Blocks from another pool, or with no callback, stay with the caller.
+        {
+            StaticEventDispatcher<4> events;
+            StaticObjectPool<Payload, 1> other;
+            Payload *block = other.Allocate();
+            Test_Check(test, !events.PostOwned(2, other, block));
+            events.RegisterEventCallback(2, OnOwned, PriorityNormal);
+            Test_Check(test, !events.PostOwned(2, payloads, block));
+            Test_CheckEqual(test, 1, other.InUse());
+        }
+    }
+}
+
+void RunObjectPoolTests(Test &test)
+{
+    TestPool(test);
+    TestArena(test);
+    TestOwnedPayloads(test);
+}
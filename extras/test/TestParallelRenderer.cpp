@@ -0,0 +1,121 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "ParallelRenderer.h"
+#include "Test.h"
+
+namespace
+{
+    struct Strip
+    {
+        std::vector<PixelColor> pixels;
+        std::vector<PixelColor> targets;
+        std::vector<uint32_t> packed;
+    };
+
+    // Strips of uneven sizes, each skipping a different set of steps.
+    std::vector<StripRenderJob> MakeJobs(std::vector<Strip> &strips)
+    {
+        const uint16_t sizes[] = { 1, 300, 1000, 37, 513, 0 };
+        const PixelType types[] = { PixelType::WS2812b, PixelType::SK6812_RGBW };
+        strips.assign(sizeof(sizes) / sizeof(sizes[0]), Strip());
+
+        std::vector<StripRenderJob> jobs;
+        uint32_t seed = 7;
+        for (uint16_t s = 0; s < strips.size(); s++)
+        {
+            Strip &strip = strips[s];
+            strip.pixels.resize(sizes[s] + 1);
+            strip.targets.resize(sizes[s] + 1);
+            strip.packed.assign(sizes[s] + 1, 0xDEADBEEF);
+            for (uint16_t i = 0; i <= sizes[s]; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                strip.pixels[i] = PixelColor((uint8_t)(seed >> 8), (uint8_t)(seed >> 16), (uint8_t)(seed >> 24), (uint8_t)seed);
+                strip.targets[i] = PixelColor((uint8_t)(seed >> 24), (uint8_t)seed, (uint8_t)(seed >> 8), (uint8_t)(seed >> 16));
+            }
+
+            StripRenderJob job;
+            job.pixels = &strip.pixels[0];
+            job.count = sizes[s];
+            job.target = s % 2 == 0 ? &strip.targets[0] : nullptr;
+            job.morphAlpha = 0.3f;
+            job.scale = s % 3 == 0 ? 1.0f : 0.6f;
+            job.packed = s != 3 ? &strip.packed[0] : nullptr;
+            job.type = types[s % 2];
+            jobs.push_back(job);
+        }
+
+        return jobs;
+    }
+
+    bool Same(const std::vector<Strip> &a, const std::vector<Strip> &b)
+    {
+        for (uint16_t s = 0; s < a.size(); s++)
+        {
+            if (a[s].packed != b[s].packed) { return false; }
+            for (uint16_t i = 0; i < a[s].pixels.size(); i++)
+            {
+                const PixelColor &x = a[s].pixels[i];
+                const PixelColor &y = b[s].pixels[i];
+                if (x.Red() != y.Red() || x.Green() != y.Green()
+                    || x.Blue() != y.Blue() || x.White() != y.White())
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+void RunParallelRendererTests(Test &test)
+{
+    // Reference: every step applied directly, one pixel at a time.
+    std::vector<Strip> expected;
+    std::vector<StripRenderJob> jobs = MakeJobs(expected);
+    for (const StripRenderJob &job : jobs)
+    {
+        for (uint16_t i = 0; i < job.count; i++)
+        {
+            if (job.target != nullptr) { job.pixels[i].Morph(&job.target[i], job.morphAlpha); }
+            if (job.scale != 1.0f) { job.pixels[i].ScaleColor(job.scale); }
+            if (job.packed != nullptr) { job.packed[i] = job.pixels[i].PackedValue(job.type); }
+        }
+    }
+
+    // Any thread count and segment size gives the same pixels, and nothing past the
+    // end of a strip is touched.
+    const uint8_t threadCounts[] = { 1, 2, 4 };
+    const uint16_t segmentSizes[] = { 1, 7, 256 };
+    for (uint8_t threads : threadCounts)
+    {
+        for (uint16_t segmentSize : segmentSizes)
+        {
+            ParallelRenderer renderer(threads, segmentSize);
+            Test_CheckEqual(test, threads, renderer.ThreadCount());
+
+            std::vector<Strip> strips;
+            jobs = MakeJobs(strips);
+            renderer.RenderFrame(&jobs[0], (uint16_t)jobs.size());
+            Test_Check(test, Same(strips, expected));
+
+            // The workers are reused frame after frame.
+            for (uint8_t frame = 0; frame < 20; frame++)
+            {
+                jobs = MakeJobs(strips);
+                renderer.RenderFrame(&jobs[0], (uint16_t)jobs.size());
+            }
+            Test_Check(test, Same(strips, expected));
+
+            renderer.RenderFrame(nullptr, 0);
+        }
+    }
+
+    ParallelRenderer automatic;
+    Test_Check(test, automatic.ThreadCount() >= 1);
+}
@@ -0,0 +1,126 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "ParallelStripEncoder.h"
+#include "Test.h"
+
+namespace
+{
+    const uint16_t pixelCount = 45;
+
+    // The wire bit sent for one strip, worked out one bit at a time.
+    bool WireBit(
+        const std::vector<const uint32_t *> &lanes,
+        const std::vector<uint16_t> &lengths,
+        uint8_t lane,
+        uint16_t pixel,
+        uint8_t wireByte,
+        uint8_t bit)
+    {
+        if (lanes[lane] == nullptr || pixel >= lengths[lane]) { return false; }
+        return (lanes[lane][pixel] >> (24 - 8 * wireByte + bit)) & 1;
+    }
+
+    // Port entries for pixels [start, start + count): each wire byte is sent most
+    // significant bit first, and strip n is port bit n.
+    std::vector<uint16_t> Reference(
+        const std::vector<const uint32_t *> &lanes,
+        const std::vector<uint16_t> &lengths,
+        uint16_t start,
+        uint16_t count,
+        PixelType type)
+    {
+        uint8_t bytesPerPixel = ParallelStripEncoder::BytesPerPixel(type);
+        std::vector<uint16_t> out;
+        for (uint16_t pixel = start; pixel < start + count; pixel++)
+        {
+            for (uint8_t wireByte = 0; wireByte < bytesPerPixel; wireByte++)
+            {
+                for (int8_t bit = 7; bit >= 0; bit--)
+                {
+                    uint16_t entry = 0;
+                    for (uint8_t lane = 0; lane < lanes.size(); lane++)
+                    {
+                        if (WireBit(lanes, lengths, lane, pixel, wireByte, (uint8_t)bit))
+                        {
+                            entry |= (uint16_t)(1u << lane);
+                        }
+                    }
+                    out.push_back(entry);
+                }
+            }
+        }
+
+        return out;
+    }
+}
+
+void RunParallelStripEncoderTests(Test &test)
+{
+    Test_CheckEqual(test, 3, ParallelStripEncoder::BytesPerPixel(PixelType::WS2812b));
+    Test_CheckEqual(test, 4, ParallelStripEncoder::BytesPerPixel(PixelType::SK6812_RGBW));
+    Test_CheckEqual(test, 24u * 10, ParallelStripEncoder::EncodedLength(10, PixelType::WS2812b));
+    Test_CheckEqual(test, 32u * 10, ParallelStripEncoder::EncodedLength(10, PixelType::SK6812_RGBW));
+
+    // Random packed values for 16 strips of different lengths, one of them missing.
+    std::vector<std::vector<uint32_t>> strips(16, std::vector<uint32_t>(pixelCount));
+    uint32_t seed = 5;
+    for (std::vector<uint32_t> &strip : strips)
+    {
+        for (uint32_t &value : strip)
+        {
+            seed = seed * 1103515245 + 12345;
+            value = seed ^ (seed << 13);
+        }
+    }
+
+    const PixelType types[] = { PixelType::WS2812b, PixelType::SK6812_RGBW };
+    for (PixelType type : types)
+    {
+        bool matches8 = true;
+        bool matches16 = true;
+        for (uint8_t laneCount = 1; laneCount <= 16; laneCount++)
+        {
+            std::vector<const uint32_t *> lanes;
+            std::vector<uint16_t> lengths;
+            for (uint8_t lane = 0; lane < laneCount; lane++)
+            {
+                lanes.push_back(lane == 5 ? nullptr : &strips[lane][0]);
+                lengths.push_back((uint16_t)(pixelCount - (lane * 7) % 20));
+            }
+
+            // Whole frames, and the same frame in uneven chunks.
+            const uint16_t chunks[][2] = { { 0, pixelCount }, { 0, 1 }, { 1, 17 }, { 18, 27 } };
+            for (const uint16_t *chunk : chunks)
+            {
+                std::vector<uint16_t> expected = Reference(lanes, lengths, chunk[0], chunk[1], type);
+                uint32_t length = ParallelStripEncoder::EncodedLength(chunk[1], type);
+
+                if (laneCount <= 8)
+                {
+                    std::vector<uint8_t> out(length + 1, 0xA5);
+                    ParallelStripEncoder::Encode8(&lanes[0], &lengths[0], laneCount, chunk[0], chunk[1], type, &out[0]);
+                    for (uint32_t i = 0; i < length; i++) { matches8 = matches8 && out[i] == expected[i]; }
+                    matches8 = matches8 && out[length] == 0xA5;
+                }
+
+                std::vector<uint16_t> out(length + 1, 0xA5A5);
+                ParallelStripEncoder::Encode16(&lanes[0], &lengths[0], laneCount, chunk[0], chunk[1], type, &out[0]);
+                for (uint32_t i = 0; i < length; i++) { matches16 = matches16 && out[i] == expected[i]; }
+                matches16 = matches16 && out[length] == 0xA5A5;
+            }
+
+            // Without lengths every strip is taken to be long enough.
+            std::vector<uint16_t> full(laneCount, pixelCount);
+            std::vector<uint16_t> expected = Reference(lanes, full, 0, pixelCount, type);
+            std::vector<uint16_t> out(ParallelStripEncoder::EncodedLength(pixelCount, type));
+            ParallelStripEncoder::Encode16(&lanes[0], nullptr, laneCount, 0, pixelCount, type, &out[0]);
+            matches16 = matches16 && out == expected;
+        }
+        Test_Check(test, matches8);
+        Test_Check(test, matches16);
+    }
+}
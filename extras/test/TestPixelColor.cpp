@@ -0,0 +1,159 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "PixelColor.h"
+#include "PixelColorTable.h"
+#include "Test.h"
+
+namespace
+{
+    // Constant-initialized at compile time, as on the board.
+    constexpr PixelColor amber(255, 120, 0, 10);
+    static_assert(amber.Red() == 255 && amber.Green() == 120 && amber.White() == 10, "constexpr PixelColor");
+
+    const PixelColor presets[] PixelColorTable_PROGMEM =
+    {
+        PixelColor(255, 0, 0),
+        PixelColor(0, 255, 0, 7),
+        PixelColor(0, 0, 255, 9),
+    };
+    constexpr PixelColorTable presetTable(presets, 3);
+    static_assert(presetTable.Count() == 3, "constexpr PixelColorTable");
+
+    bool Equal(const PixelColor &a, const PixelColor &b)
+    {
+        return a.Red() == b.Red() && a.Green() == b.Green()
+            && a.Blue() == b.Blue() && a.White() == b.White();
+    }
+
+    void TestTable(Test &test)
+    {
+        Test_Check(test, Equal(presets[1], presetTable.At(1)));
+        Test_Check(test, Equal(PixelColor(), presetTable.At(3)));
+
+        PixelColor out[4] = { amber, amber, amber, amber };
+        Test_CheckEqual(test, 2, presetTable.CopyTo(out, 1, 4));
+        Test_Check(test, Equal(presets[1], out[0]));
+        Test_Check(test, Equal(presets[2], out[1]));
+        Test_Check(test, Equal(amber, out[2]));
+        Test_CheckEqual(test, 0, presetTable.CopyTo(out, 3, 1));
+    }
+
+    // Correction applied channel by channel, then packed without one.
+    uint32_t CorrectedReference(const PixelColor &color, PixelType type, const PixelCorrection &correction)
+    {
+        bool isRGBW = type == PixelType::SK6812_RGBW;
+        uint32_t r = color.Red();
+        uint32_t g = color.Green();
+        uint32_t b = color.Blue();
+        uint32_t w = color.White();
+
+        if (isRGBW && correction.whiteExtraction != WhiteExtraction::WhitePassthrough)
+        {
+            uint32_t shared = r < g ? (r < b ? r : b) : (g < b ? g : b);
+            w += shared;
+            if (correction.whiteExtraction == WhiteExtraction::WhiteReplace)
+            {
+                r -= shared;
+                g -= shared;
+                b -= shared;
+            }
+        }
+
+        r = r * correction.redScale / 256;
+        g = g * correction.greenScale / 256;
+        b = b * correction.blueScale / 256;
+        w = w * correction.whiteScale / 256;
+
+        PixelColor corrected(
+            (uint8_t)(r > 255 ? 255 : r),
+            (uint8_t)(g > 255 ? 255 : g),
+            (uint8_t)(b > 255 ? 255 : b),
+            (uint8_t)(w > 255 ? 255 : w));
+        return corrected.PackedValue(type);
+    }
+
+    void TestPacking(Test &test)
+    {
+        const uint16_t count = 50;
+        PixelColor pixels[count];
+        uint32_t seed = 21;
+        for (uint16_t i = 0; i < count; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            pixels[i] = PixelColor((uint8_t)(seed >> 8), (uint8_t)(seed >> 16), (uint8_t)(seed >> 24), (uint8_t)seed);
+        }
+        pixels[0] = PixelColor(255, 255, 255, 255);
+        pixels[1] = PixelColor(200, 150, 100, 0);
+
+        const PixelCorrection unity =
+            { WhitePassthrough, PixelCorrection_Unity, PixelCorrection_Unity, PixelCorrection_Unity, PixelCorrection_Unity };
+        const PixelCorrection corrections[] =
+        {
+            unity,
+            { WhiteReplace, 256, 256, 256, 256 },
+            { WhiteBoost, 256, 256, 256, 256 },
+            { WhiteReplace, 300, 180, 256, 400 },
+            { WhitePassthrough, 0, 512, 128, 256 },
+        };
+
+        for (uint8_t t = 0; t < PixelType::PIXEL_TYPE_Count; t++)
+        {
+            PixelType type = (PixelType)t;
+            uint32_t packed[count];
+
+            // PackStrip matches PackedValue, and a unity correction changes nothing.
+            PixelColor::PackStrip(pixels, packed, count, type);
+            bool matches = true;
+            for (uint16_t i = 0; i < count; i++)
+            {
+                matches = matches && packed[i] == pixels[i].PackedValue(type);
+                matches = matches && pixels[i].PackedValue(type, unity) == packed[i];
+            }
+            Test_Check(test, matches);
+
+            // Each channel lands in its own byte, and only RGBW sends white.
+            uint32_t red = PixelColor(0xFF, 0, 0, 0).PackedValue(type);
+            uint32_t green = PixelColor(0, 0xFF, 0, 0).PackedValue(type);
+            uint32_t blue = PixelColor(0, 0, 0xFF, 0).PackedValue(type);
+            uint32_t white = PixelColor(0, 0, 0, 0xFF).PackedValue(type);
+            Test_Check(test, red != 0 && green != 0 && blue != 0);
+            Test_Check(test, (red & green) == 0 && (red & blue) == 0 && (green & blue) == 0);
+            Test_Check(test, type == PixelType::SK6812_RGBW ? (white & (red | green | blue)) == 0 && white != 0 : white == 0);
+
+            for (const PixelCorrection &correction : corrections)
+            {
+                PixelColor::PackStrip(pixels, packed, count, type, &correction);
+                matches = true;
+                for (uint16_t i = 0; i < count; i++)
+                {
+                    uint32_t expected = CorrectedReference(pixels[i], type, correction);
+                    matches = matches && packed[i] == expected;
+                    matches = matches && pixels[i].PackedValue(type, correction) == expected;
+                }
+                Test_Check(test, matches);
+            }
+        }
+
+        // White extraction on an RGBW pixel: replace moves the shared 100 to white,
+        // boost adds it and keeps the color, and white saturates.
+        const PixelCorrection replace = { WhiteReplace, 256, 256, 256, 256 };
+        const PixelCorrection boost = { WhiteBoost, 256, 256, 256, 256 };
+        Test_CheckEqual(test,
+            PixelColor(100, 50, 0, 100).PackedValue(PixelType::SK6812_RGBW),
+            pixels[1].PackedValue(PixelType::SK6812_RGBW, replace));
+        Test_CheckEqual(test,
+            PixelColor(200, 150, 100, 100).PackedValue(PixelType::SK6812_RGBW),
+            pixels[1].PackedValue(PixelType::SK6812_RGBW, boost));
+        Test_CheckEqual(test,
+            PixelColor(255, 255, 255, 255).PackedValue(PixelType::SK6812_RGBW),
+            pixels[0].PackedValue(PixelType::SK6812_RGBW, boost));
+    }
+}
+
+void RunPixelColorTests(Test &test)
+{
+    TestTable(test);
+    TestPacking(test);
+}
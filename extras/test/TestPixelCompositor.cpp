@@ -0,0 +1,199 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <math.h>
+
+#include "PixelCompositor.h"
+#include "Test.h"
+
+namespace
+{
+    // Floating point reference for one channel of one blend.
+    double Reference(BlendMode mode, double below, double src, double alpha)
+    {
+        switch (mode)
+        {
+            case BlendMode::BlendBase: return src * alpha;
+            case BlendMode::BlendAdd: return fmin(255, below + src * alpha);
+            case BlendMode::BlendMultiply: return below + (below * src / 255 - below) * alpha;
+            case BlendMode::BlendScreen:
+                return below + (255 - (255 - below) * (255 - src) / 255 - below) * alpha;
+            default: return below + (src - below) * alpha;
+        }
+    }
+
+    uint8_t Channel(const PixelColor &color, uint8_t c)
+    {
+        switch (c)
+        {
+            case 0: return color.Red();
+            case 1: return color.Green();
+            case 2: return color.Blue();
+            default: return color.White();
+        }
+    }
+
+    bool Equal(const PixelColor &a, const PixelColor &b)
+    {
+        return a.Red() == b.Red() && a.Green() == b.Green()
+            && a.Blue() == b.Blue() && a.White() == b.White();
+    }
+}
+
+void RunPixelCompositorTests(Test &test)
+{
+    const uint16_t count = 64;
+    PixelColor below[count];
+    PixelColor above[count];
+    PixelColor out[count];
+    uint32_t seed = 99;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t v[8];
+        for (uint8_t c = 0; c < 8; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            v[c] = (uint8_t)(seed >> 16);
+        }
+        below[i] = PixelColor(v[0], v[1], v[2], v[3]);
+        above[i] = PixelColor(v[4], v[5], v[6], v[7]);
+    }
+    below[0] = PixelColor(0, 0, 0, 0);
+    above[0] = PixelColor(255, 255, 255, 255);
+    below[1] = PixelColor(255, 255, 255, 255);
+    above[1] = PixelColor(0, 0, 0, 0);
+
+    // Every mode at a spread of opacities stays within 2 of the float result; the
+    // multiply and lerp each round once. Solid layers blend through their own path, so
+    // check them too, with the extremes of above[0] and above[1] among the colors.
+    const uint8_t opacities[] = { 1, 64, 128, 200, 255 };
+    for (uint8_t mode = 0; mode < BLEND_MODE_Count; mode++)
+    {
+        double worst = 0;
+        for (uint8_t opacity : opacities)
+        {
+            for (int8_t solid = -1; solid < 4; solid++)
+            {
+                StaticPixelCompositor<4> compositor;
+                compositor.AddLayer(BlendMode::BlendBase, below);
+                int8_t layer = solid < 0
+                    ? compositor.AddLayer((BlendMode)mode, above)
+                    : compositor.AddSolidLayer((BlendMode)mode, above[solid]);
+                compositor.SetOpacity(layer, opacity);
+                compositor.Render(out, count);
+
+                for (uint16_t i = 0; i < count; i++)
+                {
+                    const PixelColor &src = solid < 0 ? above[i] : above[solid];
+                    for (uint8_t c = 0; c < 4; c++)
+                    {
+                        double expected = Reference(
+                            (BlendMode)mode, Channel(below[i], c), Channel(src, c), opacity / 255.0);
+                        worst = fmax(worst, fabs(Channel(out[i], c) - expected));
+                    }
+                }
+            }
+        }
+        Test_Check(test, worst < 2);
+    }
+
+    // Full opacity and the identities are exact.
+    {
+        StaticPixelCompositor<4> compositor;
+        compositor.AddLayer(BlendMode::BlendBase, below);
+        int8_t layer = compositor.AddLayer(BlendMode::BlendAlphaOver, above);
+        compositor.Render(out, count);
+        bool exact = true;
+        for (uint16_t i = 0; i < count; i++) { exact = exact && Equal(out[i], above[i]); }
+        Test_Check(test, exact);
+
+        const PixelColor white(255, 255, 255, 255);
+        const PixelColor black;
+        compositor.Clear();
+        compositor.AddLayer(BlendMode::BlendBase, below);
+        compositor.AddSolidLayer(BlendMode::BlendMultiply, white);
+        compositor.AddSolidLayer(BlendMode::BlendScreen, black);
+        layer = compositor.AddSolidLayer(BlendMode::BlendAdd, black);
+        compositor.Render(out, count);
+        exact = true;
+        for (uint16_t i = 0; i < count; i++) { exact = exact && Equal(out[i], below[i]); }
+        Test_Check(test, exact);
+
+        compositor.SetColor(layer, white);
+        compositor.Render(out, count);
+        exact = true;
+        for (uint16_t i = 0; i < count; i++) { exact = exact && Equal(out[i], white); }
+        Test_Check(test, exact);
+    }
+
+    // Ranges, disabled layers, and pixels no layer covers.
+    {
+        StaticPixelCompositor<4> compositor;
+        int8_t base = compositor.AddSolidLayer(BlendMode::BlendBase, PixelColor(10, 20, 30, 40));
+        int8_t band = compositor.AddSolidLayer(BlendMode::BlendAlphaOver, PixelColor(200, 0, 0, 0));
+        compositor.SetRange(base, 4, PixelCompositor_RangeEnd);
+        compositor.SetRange(band, 8, 12);
+        compositor.Render(out, 16);
+        Test_Check(test, Equal(out[3], PixelColor(0, 0, 0, 0)));
+        Test_Check(test, Equal(out[4], PixelColor(10, 20, 30, 40)));
+        Test_Check(test, Equal(out[8], PixelColor(200, 0, 0, 0)));
+        Test_Check(test, Equal(out[11], PixelColor(200, 0, 0, 0)));
+        Test_Check(test, Equal(out[12], PixelColor(10, 20, 30, 40)));
+
+        compositor.SetEnabled(band, false);
+        compositor.Render(out, 16);
+        Test_Check(test, Equal(out[8], PixelColor(10, 20, 30, 40)));
+
+        compositor.SetEnabled(band, true);
+        compositor.SetOpacity(band, 0);
+        compositor.Render(out, 16);
+        Test_Check(test, Equal(out[8], PixelColor(10, 20, 30, 40)));
+
+        // A count that ends part way through a tile writes exactly that many pixels.
+        out[21] = PixelColor(1, 2, 3, 4);
+        compositor.Render(out, 21);
+        Test_Check(test, Equal(out[20], PixelColor(10, 20, 30, 40)));
+        Test_Check(test, Equal(out[21], PixelColor(1, 2, 3, 4)));
+    }
+
+    // An opaque base hides what is below it, and the output may alias a layer.
+    {
+        PixelColor strip[count];
+        for (uint16_t i = 0; i < count; i++) { strip[i] = below[i]; }
+
+        StaticPixelCompositor<4> compositor;
+        compositor.AddSolidLayer(BlendMode::BlendAdd, PixelColor(255, 255, 255, 255));
+        compositor.AddLayer(BlendMode::BlendBase, strip);
+        compositor.SetOpacity(compositor.AddLayer(BlendMode::BlendAlphaOver, above), 128);
+
+        PixelColor expected[count];
+        compositor.Render(expected, count);
+        compositor.Render(strip, count);
+        bool same = true;
+        for (uint16_t i = 0; i < count; i++)
+        {
+            same = same && Equal(strip[i], expected[i]);
+            for (uint8_t c = 0; c < 4; c++)
+            {
+                double reference = Reference(
+                    BlendMode::BlendAlphaOver, Channel(below[i], c), Channel(above[i], c), 128 / 255.0);
+                same = same && fabs(Channel(expected[i], c) - reference) < 2;
+            }
+        }
+        Test_Check(test, same);
+    }
+
+    // The layer capacity and invalid handles.
+    {
+        StaticPixelCompositor<4> compositor;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            Test_CheckEqual(test, (int8_t)i, compositor.AddLayer(BlendMode::BlendAdd, above));
+        }
+        Test_CheckEqual(test, PixelCompositor_UnableToAdd, compositor.AddLayer(BlendMode::BlendAdd, above));
+        Test_CheckEqual(test, PixelCompositor_UnableToAdd, compositor.AddLayer(BlendMode::BlendAdd, nullptr));
+        compositor.SetOpacity(-1, 0);
+        compositor.SetOpacity(4, 0);
+    }
+}
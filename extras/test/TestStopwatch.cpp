@@ -0,0 +1,40 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "Stopwatch.h"
+#include "Test.h"
+
+void RunStopwatchTests(Test &test)
+{
+    HostArduino::Reset();
+
+    Stopwatch stopwatch;
+    stopwatch.Update();
+    Test_CheckEqual(test, 0, stopwatch.ElapsedTime());
+
+    // Paused until started.
+    HostArduino::AdvanceMicros(5000);
+    stopwatch.Update();
+    Test_CheckEqual(test, 0, stopwatch.ElapsedTime());
+
+    stopwatch.Start();
+    HostArduino::AdvanceMicros(2500);
+    stopwatch.Update();
+    Test_CheckEqual(test, 2, stopwatch.ElapsedTime());
+    Test_CheckEqual(test, 2500, stopwatch.ElapsedTimeMicros());
+    Test_Check(test, stopwatch.HasElapsed(2));
+    Test_Check(test, !stopwatch.HasElapsed(3));
+    Test_Check(test, stopwatch.HasElapsedMicros(2500));
+
+    stopwatch.Stop();
+    HostArduino::AdvanceMicros(10000);
+    stopwatch.Update();
+    Test_CheckEqual(test, 2500, stopwatch.ElapsedTimeMicros());
+
+    stopwatch.Reset();
+    HostArduino::AdvanceMicros(1000);
+    stopwatch.Update();
+    Test_CheckEqual(test, 1, stopwatch.ElapsedTime());
+    Test_CheckEqual(test, 1000, stopwatch.ElapsedTimeMicros());
+}
@@ -0,0 +1,175 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "TaskRunner.h"
+#include "Test.h"
+
+namespace
+{
+    std::vector<int> trace;
+    bool gate;
+    TaskRunner *runner;
+    int16_t victim;
+
+    // Walks through every kind of wait, recording each step.
+    int8_t Sequence(Task &task)
+    {
+        TaskRunner_Begin(task);
+        trace.push_back(1000 + (int)(intptr_t)task.arg);
+        for (task.counter = 0; task.counter < 3; task.counter++)
+        {
+            TaskRunner_WaitMS(task, 100);
+            trace.push_back(2000 + task.counter);
+        }
+        TaskRunner_WaitEvent(task, 5);
+        trace.push_back(3000);
+        TaskRunner_Yield(task);
+        trace.push_back(4000);
+        TaskRunner_WaitUntil(task, gate);
+        trace.push_back(5000);
+        TaskRunner_End(task);
+    }
+
+    // Sleeps task.arg milliseconds, then records it.
+    int8_t Sleeper(Task &task)
+    {
+        TaskRunner_Begin(task);
+        TaskRunner_WaitMS(task, (uint32_t)(intptr_t)task.arg);
+        trace.push_back((int)(intptr_t)task.arg);
+        TaskRunner_End(task);
+    }
+
+    // Cancels a sleeping task, one that has only just started, and itself.
+    int8_t Canceller(Task &task)
+    {
+        TaskRunner_Begin(task);
+        runner->Cancel(victim);
+        runner->Cancel(runner->Start(Sleeper, (void *)1));
+        trace.push_back(-1);
+        TaskRunner_Yield(task);
+        trace.push_back(-2);
+        TaskRunner_End(task);
+    }
+
+    int8_t SelfCanceller(Task &task)
+    {
+        TaskRunner_Begin(task);
+        runner->Cancel(victim);
+        TaskRunner_Yield(task);
+        trace.push_back(-3);
+        TaskRunner_End(task);
+    }
+
+    bool Traced(const std::vector<int> &expected)
+    {
+        bool matches = trace == expected;
+        trace.clear();
+        return matches;
+    }
+}
+
+void RunTaskRunnerTests(Test &test)
+{
+    HostArduino::Reset();
+    trace.clear();
+    gate = false;
+
+    StaticTaskRunner<300> tasks;
+    runner = &tasks;
+
+    // Each wait resumes exactly when it should.
+    int16_t handle = tasks.Start(Sequence, (void *)7);
+    Test_Check(test, tasks.IsRunning(handle));
+    Test_CheckEqual(test, 1, tasks.Run());
+    Test_Check(test, Traced({ 1007 }));
+
+    HostArduino::AdvanceMicros(99000);
+    Test_CheckEqual(test, 0, tasks.Run());
+    HostArduino::AdvanceMicros(1000);
+    tasks.Run();
+    Test_Check(test, Traced({ 2000 }));
+    Test_CheckEqual(test, 100u, tasks.Now());
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        HostArduino::AdvanceMicros(100000);
+        tasks.Run();
+    }
+    Test_Check(test, Traced({ 2001, 2002 }));
+
+    Test_CheckEqual(test, 0, tasks.Signal(4));
+    Test_CheckEqual(test, 1, tasks.Signal(5));
+    Test_CheckEqual(test, 0, tasks.Signal(5));
+    tasks.Run();
+    Test_Check(test, Traced({ 3000 }));
+    tasks.Run();
+    Test_Check(test, Traced({ 4000 }));
+    tasks.Run();
+    tasks.Run();
+    Test_Check(test, Traced({}));
+    gate = true;
+    tasks.Run();
+    Test_Check(test, Traced({ 5000 }));
+    Test_Check(test, !tasks.IsRunning(handle));
+    Test_CheckEqual(test, 0, tasks.ActiveCount());
+
+    // Sleepers started in reverse wake in order of wake time.
+    for (int i = 250; i > 0; i--) { tasks.Start(Sleeper, (void *)(intptr_t)(i * 3)); }
+    Test_CheckEqual(test, 250, tasks.Run());
+    HostArduino::AdvanceMicros(30000);
+    Test_CheckEqual(test, 10, tasks.Run());
+    Test_Check(test, Traced({ 3, 6, 9, 12, 15, 18, 21, 24, 27, 30 }));
+    HostArduino::AdvanceMicros(1000000);
+    Test_CheckEqual(test, 240, tasks.Run());
+    trace.clear();
+    Test_CheckEqual(test, 0, tasks.ActiveCount());
+
+    // Capacity is enforced, and freed slots are reused.
+    for (uint16_t i = 0; i < 300; i++) { tasks.Start(Sleeper, (void *)10); }
+    Test_CheckEqual(test, TaskRunner_UnableToStart, tasks.Start(Sleeper));
+    Test_CheckEqual(test, TaskRunner_UnableToStart, tasks.Start(nullptr));
+    tasks.Run();
+    HostArduino::AdvanceMicros(10000);
+    tasks.Run();
+    trace.clear();
+    Test_CheckEqual(test, 0, tasks.ActiveCount());
+
+    // Cancelling sleeping, waiting, ready and running tasks.
+    victim = tasks.Start(Sleeper, (void *)5000);
+    int16_t waiting = tasks.Start(Sequence, (void *)1);
+    gate = false;
+    tasks.Run();
+    HostArduino::AdvanceMicros(300000);
+    tasks.Run();
+    tasks.Run();
+    tasks.Run();
+    trace.clear();
+
+    int16_t canceller = tasks.Start(Canceller);
+    tasks.Run();
+    Test_Check(test, Traced({ -1 }));
+    Test_Check(test, !tasks.IsRunning(victim));
+    Test_Check(test, tasks.IsRunning(waiting));
+
+    tasks.Cancel(waiting);
+    tasks.Cancel(canceller);
+    Test_Check(test, !tasks.IsRunning(waiting));
+    Test_CheckEqual(test, 0, tasks.Signal(5));
+    HostArduino::AdvanceMicros(6000000);
+    tasks.Run();
+    Test_Check(test, Traced({}));
+    Test_CheckEqual(test, 0, tasks.ActiveCount());
+
+    victim = tasks.Start(SelfCanceller);
+    tasks.Run();
+    tasks.Run();
+    Test_Check(test, Traced({}));
+    Test_CheckEqual(test, 0, tasks.ActiveCount());
+
+    tasks.Cancel(-1);
+    tasks.Cancel(300);
+    Test_Check(test, !tasks.IsRunning(300));
+}
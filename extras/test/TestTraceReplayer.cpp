@@ -0,0 +1,121 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include <vector>
+
+#include "Button.h"
+#include "CallbackHandler.h"
+#include "TraceRecorder.h"
+#include "TraceReplayer.h"
+#include "Test.h"
+
+namespace
+{
+    const uint32_t mainPin = 2;
+    const uint32_t auxPin = 3;
+
+    std::vector<uint16_t> callbackValues;
+
+    void OnCallback(void *arg)
+    {
+        callbackValues.push_back(*static_cast<uint16_t *>(arg));
+    }
+
+    // Whether each button is held at a time in the session: a short press and a long
+    // press of the main button, a latching aux toggle, then idle so both buttons end
+    // up settled for the replay.
+    bool MainHeld(uint32_t ms)
+    {
+        return (ms >= 100 && ms < 180) || (ms >= 400 && ms < 1300) || (ms >= 1500 && ms < 1530);
+    }
+
+    bool AuxHeld(uint32_t ms)
+    {
+        return ms >= 700 && ms < 900;
+    }
+}
+
+void RunTraceReplayerTests(Test &test)
+{
+    HostArduino::Reset();
+    Button main(mainPin, ButtonType::Momentary, ButtonPolarity::ActiveLow, 500);
+    Button aux(auxPin, ButtonType::Latching, ButtonPolarity::ActiveHigh, 500);
+
+    // Record the session the way the board loop would, every 10 ms.
+    std::vector<TraceRecord> buffer(512);
+    TraceRecorder recorder(&buffer[0], (uint16_t)buffer.size());
+    HostArduino::SetPinLevel(mainPin, HIGH);
+    HostArduino::SetPinLevel(auxPin, LOW);
+    recorder.Start();
+
+    uint32_t recordedStates = 0;
+    Stopwatch probe;
+    for (uint32_t ms = 10; ms <= 2000; ms += 10)
+    {
+        HostArduino::SetMillis(ms);
+        HostArduino::SetPinLevel(mainPin, MainHeld(ms) ? LOW : HIGH);
+        HostArduino::SetPinLevel(auxPin, AuxHeld(ms) ? HIGH : LOW);
+
+        probe.Reset();
+        recordedStates += recorder.SampleButton(main) != ButtonState::NotPressed;
+        recordedStates += recorder.SampleButton(aux) != ButtonState::NotPressed;
+        HostArduino::AdvanceMicros(250);
+        probe.Update();
+        recorder.RecordProbe(1, probe);
+
+        if (ms % 500 == 0) { recorder.RecordCallback(4, (uint16_t)ms); }
+    }
+    recorder.Stop();
+    Test_CheckEqual(test, 0u, recorder.DroppedCount());
+    Test_Check(test, recordedStates >= 5);
+
+    std::vector<uint8_t> serialized(recorder.SerializedSize());
+    Test_CheckEqual(test,
+        (uint32_t)serialized.size(),
+        recorder.Serialize(&serialized[0], (uint32_t)serialized.size()));
+
+    // Replaying through the same buttons reproduces every state.
+    TraceReplayer replayer;
+    Test_Check(test, replayer.Load(&serialized[0], serialized.size()));
+    Test_CheckEqual(test, (size_t)recorder.Count(), replayer.Count());
+
+    CallbackHandler handler;
+    handler.RegisterCallback(OnCallback);
+    replayer.AttachButton(&main, mainPin, ButtonPolarity::ActiveLow);
+    replayer.AttachButton(&aux, auxPin, ButtonPolarity::ActiveHigh);
+    replayer.AttachCallback(4, &handler);
+
+    TraceReplayResult result = replayer.Replay(10);
+    Test_CheckEqual(test, (uint32_t)recorder.Count(), result.records);
+    Test_CheckEqual(test, recordedStates, result.recordedStates);
+    Test_CheckEqual(test, recordedStates, result.replayedStates);
+    Test_CheckEqual(test, 0u, result.stateMismatches);
+    Test_CheckEqual(test, 2000u, result.durationMS);
+    Test_CheckEqual(test, 200u, result.probes);
+    Test_CheckEqual(test, 250, result.probeMaxMicros);
+    Test_CheckEqual(test, 200u * 250, result.probeTotalMicros);
+    Test_CheckEqual(test, 4u, result.callbacksFired);
+    Test_Check(test, callbackValues == std::vector<uint16_t>({ 500, 1000, 1500, 2000 }));
+
+    // The buttons are left settled, so the trace can be replayed again.
+    callbackValues.clear();
+    result = replayer.Replay(10);
+    Test_CheckEqual(test, recordedStates, result.replayedStates);
+    Test_CheckEqual(test, 0u, result.stateMismatches);
+    Test_CheckEqual(test, 4u, (uint32_t)callbackValues.size());
+
+    // Damaged traces are refused.
+    Test_Check(test, !replayer.Load(&serialized[0], TraceRecorder_HeaderSize - 1));
+    Test_Check(test, !replayer.Load(&serialized[0], serialized.size() - 1));
+    serialized[0] ^= 0xFF;
+    Test_Check(test, !replayer.Load(&serialized[0], serialized.size()));
+
+    // The level SampleButton records is the one the state was decided from, even if
+    // the pin has moved since.
+    HostArduino::SetPinLevel(auxPin, HIGH);
+    aux.DetermineButtonState();
+    HostArduino::SetPinLevel(auxPin, LOW);
+    Test_Check(test, aux.WasPressed());
+    Test_Check(test, !aux.IsPressed());
+}
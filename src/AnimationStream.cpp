@@ -0,0 +1,210 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "AnimationStream.h"
+
+AnimationStream::AnimationStream()
+    : _data(nullptr)
+    , _size(0)
+    , _reader(&AnimationStream::ReadRam)
+    , _firstFrame(0)
+    , _position(0)
+    , _pixelCount(0)
+    , _frameCount(0)
+    , _frameDurationMS(0)
+    , _frameIndex(0)
+    , _paletteSize(0)
+{
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t AnimationStream::PixelCount() const
+{
+    return this->_pixelCount;
+}
+
+uint16_t AnimationStream::FrameCount() const
+{
+    return this->_frameCount;
+}
+
+uint16_t AnimationStream::FrameDurationMS() const
+{
+    return this->_frameDurationMS;
+}
+
+uint16_t AnimationStream::FrameIndex() const
+{
+    return this->_frameIndex;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+int8_t AnimationStream::Open(const uint8_t *data, uint32_t size, AnimationByteReader reader)
+{
+    this->_data = data;
+    this->_size = size;
+    this->_reader = reader != nullptr ? reader : &AnimationStream::ReadRam;
+    this->_frameCount = 0;
+    this->_frameIndex = 0;
+
+    if (data == nullptr
+        || size < AnimationStream_HeaderSize
+        || Read(0) != 'C' || Read(1) != 'G' || Read(2) != 'A'
+        || Read(3) != AnimationStream_Version)
+    {
+        return AnimationStream_InvalidData;
+    }
+
+    this->_paletteSize = Read(10);
+    uint32_t firstFrame = AnimationStream_HeaderSize + (uint32_t)this->_paletteSize * 4;
+    if (firstFrame > size) { return AnimationStream_InvalidData; }
+
+    this->_pixelCount = (uint16_t)(Read(4) | (Read(5) << 8));
+    this->_frameCount = (uint16_t)(Read(6) | (Read(7) << 8));
+    this->_frameDurationMS = (uint16_t)(Read(8) | (Read(9) << 8));
+    this->_firstFrame = firstFrame;
+    this->_position = firstFrame;
+
+    return 0;
+}
+
+int8_t AnimationStream::DecodeNextFrame(PixelColor *pixels, uint16_t count)
+{
+    if (this->_frameIndex >= this->_frameCount) { return 0; }
+
+    uint32_t pixel = 0;
+    uint32_t position = this->_position;
+
+    while (true)
+    {
+        if (position >= this->_size) { return AnimationStream_InvalidData; }
+
+        uint8_t opByte = Read(position++);
+        uint8_t op = opByte >> 5;
+        uint16_t n = (opByte & 0x1F) + 1;
+
+        if (op == AnimationOp_End) { break; }
+
+        if (op == AnimationOp_Key)
+        {
+            for (uint16_t i = 0; i < count; i++) { pixels[i] = PixelColor(); }
+            pixel = 0;
+            continue;
+        }
+
+        if (op == AnimationOp_SkipLong)
+        {
+            if (position >= this->_size) { return AnimationStream_InvalidData; }
+            n = (uint16_t)((((uint16_t)opByte & 0x1F) << 8) | Read(position++)) + 1;
+        }
+
+        // Every remaining op covers n pixels; keep them inside the frame.
+        if (pixel + n > this->_pixelCount) { return AnimationStream_InvalidData; }
+
+        switch (op)
+        {
+            case AnimationOp_Skip:
+            case AnimationOp_SkipLong:
+                break;
+
+            case AnimationOp_Run:
+            case AnimationOp_Rgb:
+            case AnimationOp_Rgbw:
+            {
+                PixelColor color;
+                if (op == AnimationOp_Run)
+                {
+                    if (position + 1 > this->_size) { return AnimationStream_InvalidData; }
+                    uint8_t index = Read(position++);
+                    if (index >= this->_paletteSize) { return AnimationStream_InvalidData; }
+                    color = PaletteColor(index);
+                }
+                else
+                {
+                    uint8_t channels = op == AnimationOp_Rgbw ? 4 : 3;
+                    if (position + channels > this->_size) { return AnimationStream_InvalidData; }
+                    color = PixelColor(
+                        Read(position),
+                        Read(position + 1),
+                        Read(position + 2),
+                        channels == 4 ? Read(position + 3) : 0);
+                    position += channels;
+                }
+
+                uint32_t end = pixel + n < count ? pixel + n : count;
+                for (uint32_t i = pixel; i < end; i++) { pixels[i] = color; }
+                break;
+            }
+
+            case AnimationOp_Index:
+            {
+                if (position + n > this->_size) { return AnimationStream_InvalidData; }
+                for (uint16_t i = 0; i < n; i++)
+                {
+                    uint8_t index = Read(position++);
+                    if (index >= this->_paletteSize) { return AnimationStream_InvalidData; }
+                    if (pixel + i < count) { pixels[pixel + i] = PaletteColor(index); }
+                }
+                break;
+            }
+
+            default:
+                return AnimationStream_InvalidData;
+        }
+
+        pixel += n;
+    }
+
+    this->_position = position;
+    this->_frameIndex++;
+
+    return 1;
+}
+
+void AnimationStream::Rewind()
+{
+    this->_position = this->_firstFrame;
+    this->_frameIndex = 0;
+}
+
+uint8_t AnimationStream::ReadRam(const uint8_t *address)
+{
+    return *address;
+}
+
+#ifdef __AVR__
+uint8_t AnimationStream::ReadProgmem(const uint8_t *address)
+{
+    return pgm_read_byte(address);
+}
+#endif
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+uint8_t AnimationStream::Read(uint32_t offset) const
+{
+    return this->_reader(this->_data + offset);
+}
+
+PixelColor AnimationStream::PaletteColor(uint8_t index) const
+{
+    uint32_t offset = AnimationStream_HeaderSize + (uint32_t)index * 4;
+    return PixelColor(Read(offset), Read(offset + 1), Read(offset + 2), Read(offset + 3));
+}
+
+// ------------------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    AnimationStream.h
+  * @author  Naigon's Electronic Creations
+  * @brief   AnimationStream
+  *          Decoder for a compact, precomputed strip animation. Frames are stored as
+  *          changes from the previous frame: skipped spans, runs of one color and
+  *          literal palette indices, so a frame costs a few bytes per changed pixel.
+  *          Decoding reads the stream one byte at a time straight from its source
+  *          (RAM, PROGMEM or a memory-mapped file) into the caller's pixel array;
+  *          nothing but a few offsets is kept in RAM.
+  *
+  *          Streams are produced on the host with AnimationEncoder (see extras/host).
+  *
+  *          Layout, multi-byte values little-endian:
+  *            'C' 'G' 'A' version(1)
+  *            pixelCount(uint16) | frameCount(uint16) | frameDurationMS(uint16)
+  *            paletteSize(uint8) | paletteSize * (r, g, b, w)
+  *            frameCount * frame
+  *
+  *          A frame is a list of ops ending with AnimationOp_End. Each op byte holds
+  *          the op in its top 3 bits and a count n - 1 (so n is 1..32) in the low 5:
+  *            End           end of frame
+  *            Skip n        leave n pixels as they were
+  *            Run n, i      n pixels of palette entry i
+  *            Index n, i*n  n literal palette indices
+  *            Rgb n, r g b  n pixels of one color, white 0
+  *            Rgbw n, r g b w
+  *            Key           keyframe: clear the strip to black before the ops that
+  *                          follow; decoding can start at any keyframe
+  *            SkipLong, b   skip ((low 5 bits << 8) | b) + 1 pixels
+  *************************************************************************************
+**/
+
+#ifndef __AnimationStream_H_
+#define __AnimationStream_H_
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+#define AnimationStream_Version 1
+#define AnimationStream_HeaderSize 11
+
+#define AnimationStream_InvalidData -1
+
+#define AnimationOp_End 0
+#define AnimationOp_Skip 1
+#define AnimationOp_Run 2
+#define AnimationOp_Index 3
+#define AnimationOp_Rgb 4
+#define AnimationOp_Rgbw 5
+#define AnimationOp_Key 6
+#define AnimationOp_SkipLong 7
+
+#define AnimationOp_MaxCount 32
+
+// Reads one byte of the stream. Lets the same decoder read from RAM, program memory
+// or any other addressable storage.
+typedef uint8_t (*AnimationByteReader)(const uint8_t *address);
+
+class AnimationStream
+{
+  public:
+    AnimationStream();
+
+    /**
+     * @brief   Open a stream and position it at the first frame.
+     *
+     * @param   data
+     *          Start of the stream. Not copied; must stay valid while playing.
+     *
+     * @param   size
+     *          Size of the stream in bytes.
+     *
+     * @param   reader
+     *          How to read bytes from data. Defaults to plain RAM reads. On AVR pass
+     *          AnimationStream::ReadProgmem for streams stored in PROGMEM.
+     *
+     * @return  Zero (0) if the header is valid; otherwise AnimationStream_InvalidData.
+     **/
+    int8_t Open(const uint8_t *data, uint32_t size, AnimationByteReader reader = nullptr);
+
+    /**
+     * @brief   Number of pixels each frame describes.
+     **/
+    uint16_t PixelCount() const;
+
+    /**
+     * @brief   Number of frames in the stream.
+     **/
+    uint16_t FrameCount() const;
+
+    /**
+     * @brief   Intended time each frame is shown for.
+     **/
+    uint16_t FrameDurationMS() const;
+
+    /**
+     * @brief   Index of the frame the next call to DecodeNextFrame will produce.
+     **/
+    uint16_t FrameIndex() const;
+
+    /**
+     * @brief   Apply the next frame to the pixel array. The array must hold the
+     *          previous frame, since only changed pixels are written.
+     *
+     * @param   pixels
+     *          Pixel array to update.
+     *
+     * @param   count
+     *          Size of the pixel array. Pixels past this are decoded but not written,
+     *          so a stream can drive a shorter strip.
+     *
+     * @return  One (1) if a frame was decoded; zero (0) if the stream has ended;
+     *          AnimationStream_InvalidData if the frame data is corrupt.
+     **/
+    int8_t DecodeNextFrame(PixelColor *pixels, uint16_t count);
+
+    /**
+     * @brief   Return to the first frame. The first frame is always a keyframe, so
+     *          playback can loop without clearing the strip.
+     **/
+    void Rewind();
+
+    /**
+     * @brief   AnimationByteReader for streams in RAM or memory-mapped files.
+     **/
+    static uint8_t ReadRam(const uint8_t *address);
+
+#ifdef __AVR__
+    /**
+     * @brief   AnimationByteReader for streams declared PROGMEM.
+     **/
+    static uint8_t ReadProgmem(const uint8_t *address);
+#endif
+
+  private:
+    uint8_t Read(uint32_t offset) const;
+    PixelColor PaletteColor(uint8_t index) const;
+
+    const uint8_t *_data;
+    uint32_t _size;
+    AnimationByteReader _reader;
+    uint32_t _firstFrame;
+    uint32_t _position;
+    uint16_t _pixelCount;
+    uint16_t _frameCount;
+    uint16_t _frameDurationMS;
+    uint16_t _frameIndex;
+    uint8_t _paletteSize;
+};
+
+#endif //__AnimationStream_H_
@@ -17,6 +17,7 @@
 
 #define _isLongPressHandled _b_1
 #define _isCooloff _b_2
+#define _isPressedSample _b_3
 
 
 namespace ButtonHelpers
@@ -31,12 +32,18 @@ Button::Button(uint32_t pin, ButtonType bType, ButtonPolarity bPolarity, uint32_
     , _pinName(pin)
     , _isLongPressHandled(false)
     , _isCooloff(false)
+    , _isPressedSample(false)
     , _heldMS(heldMS)
 {
     pinMode(pin, INPUT);
     _buttonId = ButtonHelpers::globalButtonId++;
 }
 
+bool Button::WasPressed() const
+{
+    return _isPressedSample;
+}
+
 uint8_t Button::Id() const
 {
     return _buttonId;
@@ -63,6 +70,9 @@ void Button::UpdateButtonProperties(ButtonType bType, ButtonPolarity bPolarity,
 
 ButtonState Button::DetermineButtonState()
 {
+    // Read the pin once, so every check below, and WasPressed, see the same level.
+    _isPressedSample = IsPressed();
+
     if (_buttonType == ButtonType::Momentary)
     {
         return DetermineButtonStateMomentary(_heldMS);
@@ -87,7 +97,7 @@ ButtonState Button::DetermineButtonStateMomentary(uint32_t heldMS)
         _isCooloff = false;
     }
 
-    if (IsPressed()
+    if (_isPressedSample
         && !_isLongPressHandled
         && _buttonState == ButtonState::Pressed
         && millis() >= _targetMillis)
@@ -97,7 +107,7 @@ ButtonState Button::DetermineButtonStateMomentary(uint32_t heldMS)
         _isLongPressHandled = true;
         _buttonState = ButtonState::NotPressed;
     }
-    else if (!IsPressed()
+    else if (!_isPressedSample
         && _buttonState == ButtonState::Pressed)
     {
         // If we see it's not pressed and the held test didn't pass above, the use let go before the held length. Thus,
@@ -105,13 +115,13 @@ ButtonState Button::DetermineButtonStateMomentary(uint32_t heldMS)
         result = ButtonState::ShortPress;
         _buttonState = ButtonState::NotPressed;
     }
-    else if (IsPressed() && !_isLongPressHandled)
+    else if (_isPressedSample && !_isLongPressHandled)
     {
         // We don't know if they will let go before the held time, so just mark that we are pressed.
         _targetMillis = _buttonState == ButtonState::Pressed ? _targetMillis : millis() + heldMS;
         _buttonState = ButtonState::Pressed;
     }
-    else if (!IsPressed())
+    else if (!_isPressedSample)
     {
         // Not being pressed at all so just clear everything.
         _isCooloff = _isLongPressHandled;
@@ -128,14 +138,13 @@ ButtonState Button::DetermineButtonStateLatching(uint32_t heldMS)
 {
     ButtonState result = ButtonState::NotPressed;
 
-    bool isPressed = IsPressed();
     if (_buttonState == ButtonState::NotPressed
-        && isPressed)
+        && _isPressedSample)
     {
         result = ButtonState::Pressed;
         _buttonState = ButtonState::Pressed;
     }
-    else if (!isPressed)
+    else if (!_isPressedSample)
     {
         _buttonState = ButtonState::NotPressed;
     }
@@ -92,6 +92,15 @@ class Button
      **/
     bool IsPressed() const;
 
+    /**
+     * @brief   Whether the button was pressed when DetermineButtonState last read it.
+     *          Unlike IsPressed this does not read the pin again, so it always matches
+     *          the level behind the last returned state.
+     *
+     * @return  True if the last sample was depressed or latched; otherwise false.
+     **/
+    bool WasPressed() const;
+
     /**
      * @brief   Get the unique id assigned to this button.
      *
@@ -108,7 +117,7 @@ class Button
     ButtonPolarity _buttonPolarity;
     uint8_t _u8_1;
     uint32_t _u32_1, _u32_2, _u32_3, _u32_4, _u32_5;
-    bool _b_1, _b_2;
+    bool _b_1, _b_2, _b_3;
 };
 
 #endif //__Button_H_
@@ -0,0 +1,239 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "EventDispatcher.h"
+
+EventDispatcher::EventDispatcher(EventSlot *slots, uint8_t slotCount)
+    : _slots(slots)
+    , _slotCount(slotCount > EventDispatcher_MaxEvents ? EventDispatcher_MaxEvents : slotCount)
+    , _coalescedCount(0)
+{
+    for (uint8_t i = 0; i < this->_slotCount; i++)
+    {
+        this->_slots[i].callback = nullptr;
+        this->_slots[i].payloadPool = nullptr;
+    }
+
+    for (uint8_t i = 0; i < EVENT_PRIORITY_Count; i++)
+    {
+        this->_pending[i] = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+bool EventDispatcher::HasPending() const
+{
+    uint16_t any = 0;
+    for (uint8_t i = 0; i < EVENT_PRIORITY_Count; i++)
+    {
+        any |= this->_pending[i];
+    }
+
+    return any != 0;
+}
+
+uint16_t EventDispatcher::CoalescedCount() const
+{
+    return this->_coalescedCount;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void EventDispatcher::RegisterEventCallback(const EventId& eventId, void(*callback)(void*))
+{
+    RegisterEventCallback(eventId, callback, PriorityNormal);
+}
+
+int8_t EventDispatcher::RegisterEventCallback(
+    const EventId& eventId,
+    void(*callback)(void*),
+    EventPriority priority)
+{
+    if (callback == nullptr
+        || priority >= EVENT_PRIORITY_Count
+        || FindSlot(eventId) >= 0)
+    {
+        return EventDispatcher_UnableToRegister;
+    }
+
+    for (uint8_t i = 0; i < this->_slotCount; i++)
+    {
+        EventSlot &slot = this->_slots[i];
+        if (slot.callback != nullptr) { continue; }
+
+        slot.callback = callback;
+        slot.eventId = eventId;
+        slot.priority = priority;
+        slot.payloadSize = 0;
+
+        return (int8_t)i;
+    }
+
+    return EventDispatcher_UnableToRegister;
+}
+
+void EventDispatcher::UnregisterEventCallback(int8_t token)
+{
+    if (token < 0 || token >= this->_slotCount) { return; }
+
+    EventSlot &slot = this->_slots[token];
+    if (slot.callback == nullptr) { return; }
+
+    this->_pending[slot.priority] &= ~(uint16_t)(1u << token);
+    ReleaseOwned(slot);
+    slot.callback = nullptr;
+}
+
+void EventDispatcher::UnregisterEvent(const EventId& eventId)
+{
+    UnregisterEventCallback(FindSlot(eventId));
+}
+
+bool EventDispatcher::Post(const EventId& eventId, const void *payload, uint8_t size)
+{
+    if (size > EventDispatcher_MaxPayloadSize) { return false; }
+
+    int8_t index = MarkPending(eventId);
+    if (index < 0) { return false; }
+
+    // Latest payload wins.
+    EventSlot &slot = this->_slots[index];
+    if (size > 0) { memcpy(slot.payload, payload, size); }
+    slot.payloadSize = size;
+
+    return true;
+}
+
+bool EventDispatcher::PostOwned(const EventId& eventId, ObjectPool &pool, void *block)
+{
+    if (!pool.Owns(block)) { return false; }
+
+    int8_t index = FindSlot(eventId);
+    if (index < 0) { return false; }
+
+    // Re-posting the block that is already pending must not free it.
+    EventSlot &slot = this->_slots[index];
+    if (slot.payloadPool != nullptr && slot.ownedPayload == block) { slot.payloadPool = nullptr; }
+
+    MarkPending(eventId);
+    slot.payloadPool = &pool;
+    slot.ownedPayload = block;
+    slot.payloadSize = 0;
+
+    return true;
+}
+
+uint8_t EventDispatcher::Dispatch()
+{
+    uint8_t dispatched = 0;
+    // Aligned for any built-in type, since callbacks cast the argument to their own
+    // payload type; a misaligned read faults on Cortex-M.
+    alignas(uint64_t) uint8_t payload[EventDispatcher_MaxPayloadSize];
+
+    for (uint8_t level = 0; level < EVENT_PRIORITY_Count; level++)
+    {
+        // Only events pending when the level starts run in this call, so callbacks
+        // that keep posting cannot loop forever. Each bit is cleared just before its
+        // callback: a post made before an event runs merges into that run, and only a
+        // post made once it has run carries over to the next call.
+        uint16_t snapshot = this->_pending[level];
+
+        while (snapshot != 0)
+        {
+            uint8_t index = (uint8_t)__builtin_ctz(snapshot);
+            snapshot &= snapshot - 1;
+
+            uint16_t bit = (uint16_t)(1u << index);
+            if ((this->_pending[level] & bit) == 0) { continue; }
+            this->_pending[level] &= ~bit;
+
+            EventSlot &slot = this->_slots[index];
+            if (slot.callback == nullptr) { continue; }
+
+            if (slot.payloadPool != nullptr)
+            {
+                // Ownership moves to the callback. Empty the slot before calling so a
+                // re-post starts from scratch, and the handed-off block can neither be
+                // freed by a later post nor reach the copy path below.
+                void *block = slot.ownedPayload;
+                slot.payloadPool = nullptr;
+                slot.ownedPayload = nullptr;
+                slot.payloadSize = 0;
+
+                slot.callback(block);
+                dispatched++;
+                continue;
+            }
+
+            // The callback may re-post this event, which would overwrite the slot
+            // payload while it is being read, so hand it a copy.
+            uint8_t size = slot.payloadSize;
+            memcpy(payload, slot.payload, size);
+
+            slot.callback(size > 0 ? payload : nullptr);
+            dispatched++;
+        }
+    }
+
+    return dispatched;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+int8_t EventDispatcher::FindSlot(const EventId& eventId) const
+{
+    for (uint8_t i = 0; i < this->_slotCount; i++)
+    {
+        const EventSlot &slot = this->_slots[i];
+        if (slot.callback != nullptr && slot.eventId == eventId)
+        {
+            return (int8_t)i;
+        }
+    }
+
+    return -1;
+}
+
+int8_t EventDispatcher::MarkPending(const EventId& eventId)
+{
+    int8_t index = FindSlot(eventId);
+    if (index < 0) { return -1; }
+
+    EventSlot &slot = this->_slots[index];
+    uint16_t bit = (uint16_t)(1u << index);
+
+    if (this->_pending[slot.priority] & bit)
+    {
+        this->_coalescedCount++;
+    }
+
+    // Whatever replaces a pending pooled payload, nobody will see that block now.
+    ReleaseOwned(slot);
+    this->_pending[slot.priority] |= bit;
+
+    return index;
+}
+
+void EventDispatcher::ReleaseOwned(EventSlot &slot)
+{
+    if (slot.payloadPool == nullptr) { return; }
+
+    slot.payloadPool->Free(slot.ownedPayload);
+    slot.payloadPool = nullptr;
+}
+
+// ------------------------------------------------------------------------------------
@@ -0,0 +1,238 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    EventDispatcher.h
+  * @author  Naigon's Electronic Creations
+  * @brief   EventDispatcher
+  *          Deferred, coalescing event dispatcher. Producers Post an event any number
+  *          of times during a loop iteration; only the latest payload is kept for
+  *          each pending EventId. A single call to Dispatch, typically once per frame,
+  *          then runs each pending callback exactly once, with all Critical events
+  *          running before High, High before Normal, and so on.
+  *
+  *          This keeps noisy sources (button chatter, repeated motion triggers) from
+  *          multiplying observer work, and keeps urgent events like clash or ignition
+  *          from queueing behind cosmetic ones.
+  *
+  *          No heap allocations are made: event slots are supplied by the caller, most
+  *          simply by declaring a StaticEventDispatcher sized for the sketch. Each slot
+  *          is 15 bytes on AVR. Payloads too large to copy, or that a handler needs to
+  *          keep, can be posted as ObjectPool blocks with PostOwned, handing ownership
+  *          to the callback.
+  *************************************************************************************
+**/
+
+#ifndef __EventDispatcher_H_
+#define __EventDispatcher_H_
+
+#include "Arduino.h"
+#include "IEventCallbackHandler.h"
+#include "ObjectPool.h"
+
+// Most events one dispatcher can hold. Pending events are tracked with a 16-bit mask
+// per priority.
+#define EventDispatcher_MaxEvents 16
+
+// Maximum size in bytes of a payload that is copied when an event is posted. Fixed
+// rather than configurable, since it sets the layout of every dispatcher.
+#define EventDispatcher_MaxPayloadSize 8
+
+#define EventDispatcher_UnableToRegister -1
+
+// Dispatch priority of an event. Lower values are dispatched first.
+enum EventPriority : uint8_t
+{
+    // Reactions that must not be delayed, ie clash or ignition.
+    PriorityCritical = 0,
+    PriorityHigh = 1,
+    PriorityNormal = 2,
+    // Purely visual changes that can tolerate running last in the frame.
+    PriorityCosmetic = 3,
+    EVENT_PRIORITY_Count = 4,
+};
+
+// Storage for one registered event. Used only by EventDispatcher; do not modify.
+struct EventSlot
+{
+    void(*callback)(void*);
+    EventId eventId;
+    uint8_t priority;
+    uint8_t payloadSize;
+    // Set while a PostOwned block is pending; ownedPayload is then in use.
+    ObjectPool *payloadPool;
+    union
+    {
+        uint8_t payload[EventDispatcher_MaxPayloadSize];
+        void *ownedPayload;
+    };
+};
+
+class EventDispatcher : public IEventCallbackHandler
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the EventDispatcher class.
+     *
+     * @param   slots
+     *          Storage for slotCount events. Must outlive the dispatcher.
+     *
+     * @param   slotCount
+     *          Most events that can be registered at once; values above
+     *          EventDispatcher_MaxEvents are clamped.
+     **/
+    EventDispatcher(EventSlot *slots, uint8_t slotCount);
+
+    // -------------------------------------------------------------------------------
+    // IEventCallbackHandler methods. Events registered through this method are given
+    // PriorityNormal. It returns no token, so unregister them with UnregisterEvent.
+    // -------------------------------------------------------------------------------
+    void RegisterEventCallback(const EventId& eventId, void(*callback)(void*));
+
+    /**
+     * @brief   Unregister the event callback with the given token. Any pending post
+     *          for that event is discarded, and a pending PostOwned block is freed.
+     *
+     * @param   token
+     *          Token returned by the priority overload of RegisterEventCallback.
+     **/
+    void UnregisterEventCallback(int8_t token);
+
+    /**
+     * @brief   Unregister the callback of an event, ie one registered through the
+     *          IEventCallbackHandler overload, which returns no token. Any pending post
+     *          is discarded as with UnregisterEventCallback.
+     **/
+    void UnregisterEvent(const EventId& eventId);
+
+    /**
+     * @brief   Register a callback for an event with the given priority. Only one
+     *          callback may be registered per event.
+     *
+     * @param   eventId
+     *          Id of the event to observe.
+     *
+     * @param   callback
+     *          Function called on dispatch. The argument is a pointer to a copy of
+     *          the latest posted payload, aligned for any built-in type, or nullptr if
+     *          the payload was empty.
+     *
+     *          IMPORTANT! As with CallbackHandler, the argument is short-lived and will
+     *          not be in memory after the callback is complete.
+     *
+     * @param   priority
+     *          Level at which the event is dispatched.
+     *
+     * @return  Token to use for unregister if successful; otherwise
+     *          EventDispatcher_UnableToRegister.
+     **/
+    int8_t RegisterEventCallback(
+        const EventId& eventId,
+        void(*callback)(void*),
+        EventPriority priority);
+
+    /**
+     * @brief   Marks the event as pending, copying the payload. If the event is already
+     *          pending the previous payload is replaced, so the callback will only see
+     *          the latest one.
+     *
+     * @param   eventId
+     *          Id of the event to post.
+     *
+     * @param   payload
+     *          Pointer to the payload data. May be nullptr when size is zero (0).
+     *
+     * @param   size
+     *          Size of the payload in bytes; at most EventDispatcher_MaxPayloadSize.
+     *
+     * @return  True if the event was posted; false if there is no callback for the
+     *          event or the payload is too large.
+     **/
+    bool Post(const EventId& eventId, const void *payload = nullptr, uint8_t size = 0);
+
+    /**
+     * @brief   Marks the event as pending with a pooled payload, which is passed
+     *          instead of copied. Coalesces like Post; a block that is replaced before
+     *          being dispatched is freed back to its pool.
+     *
+     *          The callback receives the block itself and owns it from then on: it
+     *          may keep it past the callback, and must Free it to the pool when done.
+     *
+     * @param   eventId
+     *          Id of the event to post.
+     *
+     * @param   pool
+     *          Pool the block was allocated from.
+     *
+     * @param   block
+     *          The payload.
+     *
+     * @return  True if the dispatcher took ownership of the block; false if there is
+     *          no callback for the event or block is not from pool, in which case the
+     *          caller still owns it.
+     **/
+    bool PostOwned(const EventId& eventId, ObjectPool &pool, void *block);
+
+    /**
+     * @brief   Runs the callback of every pending event once, in priority order.
+     *          Within one priority events run in slot order.
+     *
+     *          Posts made by a callback during dispatch:
+     *          - to an event at a lower priority level, or one at the current level
+     *            that has not run yet, are merged into this call;
+     *          - to an event that has already run, or one at a higher level, are left
+     *            pending for the next call.
+     *
+     * @return  Number of callbacks that were run.
+     **/
+    uint8_t Dispatch();
+
+    /**
+     * @brief   Whether any event is waiting to be dispatched.
+     **/
+    bool HasPending() const;
+
+    /**
+     * @brief   Number of posts that were merged into an already pending event since
+     *          the dispatcher was created. Useful to gauge how noisy the producers are.
+     **/
+    uint16_t CoalescedCount() const;
+
+  private:
+    int8_t FindSlot(const EventId& eventId) const;
+    int8_t MarkPending(const EventId& eventId);
+    void ReleaseOwned(EventSlot &slot);
+
+    EventSlot *_slots;
+    uint8_t _slotCount;
+    uint16_t _pending[EVENT_PRIORITY_Count];
+    uint16_t _coalescedCount;
+};
+
+/**
+ * @brief   EventDispatcher with its own storage for Events events. Size it to what the
+ *          sketch registers; every slot costs RAM whether it is used or not.
+ **/
+template <uint8_t Events>
+class StaticEventDispatcher : public EventDispatcher
+{
+    static_assert(Events > 0 && Events <= EventDispatcher_MaxEvents,
+        "StaticEventDispatcher holds 1 to EventDispatcher_MaxEvents events");
+
+  public:
+    StaticEventDispatcher()
+        : EventDispatcher(_slotStorage, Events)
+    {
+    }
+
+    // The base points at _slotStorage, so a copy would dispatch the original's events.
+    StaticEventDispatcher(const StaticEventDispatcher&) = delete;
+    StaticEventDispatcher& operator=(const StaticEventDispatcher&) = delete;
+
+  private:
+    EventSlot _slotStorage[Events];
+};
+
+#endif //__EventDispatcher_H_
@@ -0,0 +1,216 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "FixedFilter.h"
+
+namespace FixedFilterHelpers
+{
+    inline int16_t Saturate(int32_t value)
+    {
+        if (value > 32767) { return 32767; }
+        if (value < -32768) { return -32768; }
+        return (int16_t)value;
+    }
+
+    inline int16_t ToFixed(float value)
+    {
+        float scaled = value * (1 << FixedFilter_CoefficientBits);
+        return Saturate((int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f));
+    }
+
+    // RBJ audio EQ cookbook biquad, normalized by a0. highPass selects the numerator.
+    BiquadCoefficients Design(float cutoffHz, float sampleRateHz, float q, bool highPass)
+    {
+        float omega = 2.0f * (float)M_PI * cutoffHz / sampleRateHz;
+        float cosine = cosf(omega);
+        float alpha = sinf(omega) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+
+        float b1 = highPass ? -(1.0f + cosine) : 1.0f - cosine;
+        float b0 = highPass ? -b1 / 2.0f : b1 / 2.0f;
+
+        BiquadCoefficients result;
+        result.b0 = ToFixed(b0 / a0);
+        result.b1 = ToFixed(b1 / a0);
+        result.b2 = result.b0;
+        result.a1 = ToFixed(-2.0f * cosine / a0);
+        result.a2 = ToFixed((1.0f - alpha) / a0);
+
+        // At low cutoffs b is only a few counts, so rounding alone skews the DC gain.
+        // Choose b1 so it stays exactly one (low-pass) or zero (high-pass).
+        int16_t dcGain = highPass ? 0 : (1 << FixedFilter_CoefficientBits) + result.a1 + result.a2;
+        result.b1 = dcGain - 2 * result.b0;
+        return result;
+    }
+
+    // One section over a burst. Coefficients and history live in locals for the loop.
+    void ProcessSection(
+        const BiquadCoefficients &c,
+        BiquadState &state,
+        const int16_t *in,
+        int16_t *out,
+        uint16_t count,
+        uint8_t stride)
+    {
+        int32_t x1 = state.x1, x2 = state.x2, y1 = state.y1, y2 = state.y2;
+        int32_t remainder = state.remainder;
+
+        for (uint16_t i = 0; i < count; i++, in += stride, out += stride)
+        {
+            int32_t x = *in;
+            int32_t acc = remainder + c.b0 * x + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
+
+            // Carry the bits dropped from the output into the next sample. Without it
+            // a low cutoff filter settles up to a few hundred counts from its input.
+            int32_t y = acc >> FixedFilter_CoefficientBits;
+            remainder = acc - y * (1 << FixedFilter_CoefficientBits);
+            y = Saturate(y);
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            *out = (int16_t)y;
+        }
+
+        state.x1 = (int16_t)x1;
+        state.x2 = (int16_t)x2;
+        state.y1 = (int16_t)y1;
+        state.y2 = (int16_t)y2;
+        state.remainder = (int16_t)remainder;
+    }
+}
+
+// ------------------------------------------------------------------------------------
+// BiquadCascade
+// ------------------------------------------------------------------------------------
+
+BiquadCoefficients BiquadCascade::LowPass(float cutoffHz, float sampleRateHz, float q)
+{
+    return FixedFilterHelpers::Design(cutoffHz, sampleRateHz, q, false);
+}
+
+BiquadCoefficients BiquadCascade::HighPass(float cutoffHz, float sampleRateHz, float q)
+{
+    return FixedFilterHelpers::Design(cutoffHz, sampleRateHz, q, true);
+}
+
+BiquadCascade::BiquadCascade(
+    const BiquadCoefficients *coefficients,
+    BiquadState *states,
+    uint8_t sectionCount)
+    : _coefficients(coefficients)
+    , _states(states)
+    , _sectionCount(sectionCount)
+{
+    Reset();
+}
+
+void BiquadCascade::Reset()
+{
+    memset(this->_states, 0, this->_sectionCount * sizeof(BiquadState));
+}
+
+int16_t BiquadCascade::Process(int16_t sample)
+{
+    for (uint8_t s = 0; s < this->_sectionCount; s++)
+    {
+        FixedFilterHelpers::ProcessSection(
+            this->_coefficients[s], this->_states[s], &sample, &sample, 1, 1);
+    }
+
+    return sample;
+}
+
+void BiquadCascade::ProcessBatch(const int16_t *in, int16_t *out, uint16_t count, uint8_t stride)
+{
+    if (this->_sectionCount == 0)
+    {
+        for (uint16_t i = 0; i < count; i++) { out[i * stride] = in[i * stride]; }
+        return;
+    }
+
+    // The first section reads the input; the rest refine the output in place.
+    for (uint8_t s = 0; s < this->_sectionCount; s++)
+    {
+        FixedFilterHelpers::ProcessSection(
+            this->_coefficients[s], this->_states[s], s == 0 ? in : out, out, count, stride);
+    }
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// RunningStats
+// ------------------------------------------------------------------------------------
+
+RunningStats::RunningStats(int16_t *window, uint16_t size)
+    : _window(window)
+    , _size(size)
+{
+    Reset();
+}
+
+void RunningStats::Reset()
+{
+    this->_sum = 0;
+    this->_sumOfSquares = 0;
+    this->_count = 0;
+    this->_next = 0;
+}
+
+void RunningStats::Add(int16_t sample)
+{
+    if (this->_size == 0) { return; }
+
+    if (this->_count == this->_size)
+    {
+        int32_t oldest = this->_window[this->_next];
+        this->_sum -= oldest;
+        this->_sumOfSquares -= (uint32_t)(oldest * oldest);
+    }
+    else
+    {
+        this->_count++;
+    }
+
+    int32_t value = sample;
+    this->_window[this->_next] = sample;
+    this->_sum += value;
+    this->_sumOfSquares += (uint32_t)(value * value);
+
+    if (++this->_next == this->_size) { this->_next = 0; }
+}
+
+void RunningStats::AddBatch(const int16_t *samples, uint16_t count, uint8_t stride)
+{
+    for (uint16_t i = 0; i < count; i++, samples += stride)
+    {
+        Add(*samples);
+    }
+}
+
+uint16_t RunningStats::Count() const
+{
+    return this->_count;
+}
+
+int16_t RunningStats::Mean() const
+{
+    return this->_count == 0 ? 0 : (int16_t)(this->_sum / this->_count);
+}
+
+uint32_t RunningStats::Variance() const
+{
+    if (this->_count == 0) { return 0; }
+
+    // (n * sum(x^2) - sum(x)^2) / n^2, exact in 64 bits for any window size.
+    uint64_t n = this->_count;
+    int64_t sum = this->_sum;
+    uint64_t spread = n * this->_sumOfSquares - (uint64_t)(sum * sum);
+    return (uint32_t)(spread / (n * n));
+}
+
+// ------------------------------------------------------------------------------------
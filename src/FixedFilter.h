@@ -0,0 +1,188 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    FixedFilter.h
+  * @author  Naigon's Electronic Creations
+  * @brief   FixedFilter
+  *          Integer filters for sensor streams, so IMU samples can be filtered at the
+  *          full sensor rate without floating point:
+  *
+  *          BiquadCascade  - IIR low/high-pass filters built from biquad sections.
+  *          RunningStats   - O(1) moving average and variance over a sample window.
+  *
+  *          Every filter has a batch method that takes a whole FIFO burst at once,
+  *          which keeps coefficients and state in registers across samples.
+  *
+  *          Filter state is supplied by the caller; nothing here allocates.
+  *************************************************************************************
+**/
+
+#ifndef __FixedFilter_H_
+#define __FixedFilter_H_
+
+#include "Arduino.h"
+
+// Biquad coefficients are fixed point with this many fractional bits, giving them a
+// range of -2 to just under 2.
+#define FixedFilter_CoefficientBits 14
+
+/**
+ * @brief   Coefficients of one biquad section, normalized so a0 is one (1):
+ *          y = b0 x + b1 x[-1] + b2 x[-2] - a1 y[-1] - a2 y[-2]
+ **/
+struct BiquadCoefficients
+{
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+};
+
+/**
+ * @brief   Previous inputs and outputs of one biquad section.
+ **/
+struct BiquadState
+{
+    int16_t x1;
+    int16_t x2;
+    int16_t y1;
+    int16_t y2;
+    int16_t remainder;
+};
+
+class BiquadCascade
+{
+  public:
+    /**
+     * @brief   Butterworth style low-pass section. Uses floats, so design filters once
+     *          at startup (or at compile time on the host) rather than per sample.
+     *
+     * @param   cutoffHz
+     *          The -3dB frequency; below half of sampleRateHz.
+     *
+     * @param   sampleRateHz
+     *          Rate samples are fed in.
+     *
+     * @param   q
+     *          Resonance; 0.7071 is maximally flat. Two sections with the same
+     *          cutoff give a steeper 4th order roll off.
+     **/
+    static BiquadCoefficients LowPass(float cutoffHz, float sampleRateHz, float q = 0.7071f);
+
+    /**
+     * @brief   High-pass section, ie to remove gravity from accelerometer readings.
+     *          Parameters are the same as LowPass.
+     **/
+    static BiquadCoefficients HighPass(float cutoffHz, float sampleRateHz, float q = 0.7071f);
+
+    /**
+     * @brief   Constructs a new instance of the BiquadCascade class.
+     *
+     * @param   coefficients
+     *          One entry per section, applied in order. Not copied, so one set can be
+     *          shared by several cascades, ie one per axis.
+     *
+     * @param   states
+     *          One entry per section. Must outlive the cascade.
+     *
+     * @param   sectionCount
+     *          Number of sections.
+     **/
+    BiquadCascade(const BiquadCoefficients *coefficients, BiquadState *states, uint8_t sectionCount);
+
+    /**
+     * @brief   Clears the filter history, as though only zeros had been seen.
+     **/
+    void Reset();
+
+    /**
+     * @brief   Filters one sample.
+     *
+     *          Outputs saturate rather than wrap. The 32-bit accumulator of a
+     *          high-pass section sums up to four times its input, so keep inputs to
+     *          high-pass filters within half scale (+/-16384).
+     **/
+    int16_t Process(int16_t sample);
+
+    /**
+     * @brief   Filters a burst of samples, one section at a time.
+     *
+     * @param   in
+     *          Input samples.
+     *
+     * @param   out
+     *          Receives filtered samples; may be the same as in.
+     *
+     * @param   count
+     *          Number of samples.
+     *
+     * @param   stride
+     *          Distance between samples in both in and out, ie 3 to filter one axis
+     *          of x, y, z interleaved data in place.
+     **/
+    void ProcessBatch(const int16_t *in, int16_t *out, uint16_t count, uint8_t stride = 1);
+
+  private:
+    const BiquadCoefficients *_coefficients;
+    BiquadState *_states;
+    uint8_t _sectionCount;
+};
+
+class RunningStats
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the RunningStats class.
+     *
+     * @param   window
+     *          Ring buffer of the most recent samples. Must outlive the instance.
+     *
+     * @param   size
+     *          Number of samples the statistics cover.
+     **/
+    RunningStats(int16_t *window, uint16_t size);
+
+    /**
+     * @brief   Forgets every sample.
+     **/
+    void Reset();
+
+    /**
+     * @brief   Adds a sample, dropping the oldest once the window is full.
+     **/
+    void Add(int16_t sample);
+
+    /**
+     * @brief   Adds a burst of samples with the given stride between them.
+     **/
+    void AddBatch(const int16_t *samples, uint16_t count, uint8_t stride = 1);
+
+    /**
+     * @brief   Number of samples in the window; at most its size.
+     **/
+    uint16_t Count() const;
+
+    /**
+     * @brief   Mean of the samples in the window, rounded toward zero (0).
+     **/
+    int16_t Mean() const;
+
+    /**
+     * @brief   Population variance of the samples in the window.
+     **/
+    uint32_t Variance() const;
+
+  private:
+    int16_t *_window;
+    int32_t _sum;
+    uint64_t _sumOfSquares;
+    uint16_t _size;
+    uint16_t _count;
+    uint16_t _next;
+};
+
+#endif //__FixedFilter_H_
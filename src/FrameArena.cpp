@@ -0,0 +1,79 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "FrameArena.h"
+
+FrameArena::FrameArena(void *storage, uint16_t size)
+    : _storage((uint8_t *)storage)
+    , _size(size)
+    , _used(0)
+    , _highWaterMark(0)
+    , _failedCount(0)
+{
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t FrameArena::Capacity() const
+{
+    return this->_size;
+}
+
+uint16_t FrameArena::Used() const
+{
+    return this->_used;
+}
+
+uint16_t FrameArena::HighWaterMark() const
+{
+    return this->_highWaterMark;
+}
+
+uint16_t FrameArena::FailedCount() const
+{
+    return this->_failedCount;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void *FrameArena::Allocate(uint16_t size, uint8_t alignment)
+{
+    // Align the address rather than the offset, since storage itself may not be.
+    uintptr_t address = (uintptr_t)(this->_storage + this->_used);
+    uint16_t padding = alignment > 1
+        ? (uint16_t)((alignment - (address & (alignment - 1))) & (alignment - 1))
+        : 0;
+
+    if ((uint32_t)this->_used + padding + size > this->_size)
+    {
+        this->_failedCount++;
+        return nullptr;
+    }
+
+    uint8_t *block = this->_storage + this->_used + padding;
+    this->_used += padding + size;
+    if (this->_used > this->_highWaterMark) { this->_highWaterMark = this->_used; }
+
+    return block;
+}
+
+void FrameArena::Reset()
+{
+    this->_used = 0;
+}
+
+void FrameArena::ResetStatistics()
+{
+    this->_highWaterMark = this->_used;
+    this->_failedCount = 0;
+}
+
+// ------------------------------------------------------------------------------------
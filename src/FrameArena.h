@@ -0,0 +1,94 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    FrameArena.h
+  * @author  Naigon's Electronic Creations
+  * @brief   FrameArena
+  *          Bump allocator for scratch memory that only lives for one frame, ie
+  *          temporary pixel rows or a per-frame list of triggered effects. Allocate
+  *          just advances an offset; nothing is freed individually. Calling Reset at
+  *          the start of each frame releases everything at once.
+  *
+  *          HighWaterMark reports the most bytes any frame used, to size the arena.
+  *************************************************************************************
+**/
+
+#ifndef __FrameArena_H_
+#define __FrameArena_H_
+
+#include "Arduino.h"
+
+// Alignment used when none is given; enough for any built-in type on the supported
+// boards.
+#define FrameArena_DefaultAlignment (sizeof(void *) > 4 ? sizeof(void *) : 4)
+
+class FrameArena
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the FrameArena class.
+     *
+     * @param   storage
+     *          Memory the arena hands out. Must outlive the arena.
+     *
+     * @param   size
+     *          Size of storage in bytes.
+     **/
+    FrameArena(void *storage, uint16_t size);
+
+    /**
+     * @brief   Takes size bytes from the arena.
+     *
+     * @param   size
+     *          Number of bytes.
+     *
+     * @param   alignment
+     *          Required alignment; a power of two.
+     *
+     * @return  The memory, valid until the next Reset; or nullptr if the arena does
+     *          not have room.
+     **/
+    void *Allocate(uint16_t size, uint8_t alignment = FrameArena_DefaultAlignment);
+
+    /**
+     * @brief   Releases every allocation. Call once per frame.
+     **/
+    void Reset();
+
+    /**
+     * @brief   Size of the arena in bytes.
+     **/
+    uint16_t Capacity() const;
+
+    /**
+     * @brief   Bytes handed out since the last Reset, including alignment padding.
+     **/
+    uint16_t Used() const;
+
+    /**
+     * @brief   Most bytes used in any one frame.
+     **/
+    uint16_t HighWaterMark() const;
+
+    /**
+     * @brief   Number of Allocate calls that failed for lack of room.
+     **/
+    uint16_t FailedCount() const;
+
+    /**
+     * @brief   Restarts HighWaterMark from the current use and FailedCount from zero.
+     **/
+    void ResetStatistics();
+
+  private:
+    uint8_t *_storage;
+    uint16_t _size;
+    uint16_t _used;
+    uint16_t _highWaterMark;
+    uint16_t _failedCount;
+};
+
+#endif //__FrameArena_H_
@@ -27,7 +27,7 @@ struct IEventCallbackHandler
         const EventId& eventId,
         void(*callback)(void*)) = 0;
 
-    virtual void UnregisterEventCallback(int8_t);
+    virtual void UnregisterEventCallback(int8_t) = 0;
 };
 
 #endif
@@ -0,0 +1,215 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "IndexedPixelBuffer.h"
+
+namespace IndexedPixelBufferHelpers
+{
+    const PixelColor black;
+}
+
+uint16_t IndexedPixelBuffer::StorageSize(uint16_t count, uint8_t bitsPerPixel)
+{
+    return bitsPerPixel == 4
+        ? (uint16_t)((count + 1) / 2)
+        : count;
+}
+
+IndexedPixelBuffer::IndexedPixelBuffer(
+    uint8_t *storage,
+    uint16_t count,
+    uint8_t bitsPerPixel,
+    PixelColor *palette,
+    uint16_t paletteSize)
+    : _storage(storage)
+    , _palette(palette)
+    , _count(count)
+    , _paletteSize(palette != nullptr ? paletteSize : 0)
+    , _bitsPerPixel(bitsPerPixel == 4 ? 4 : 8)
+{
+    memset(this->_storage, 0, StorageSize(count, this->_bitsPerPixel));
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t IndexedPixelBuffer::Count() const
+{
+    return this->_count;
+}
+
+uint8_t IndexedPixelBuffer::BitsPerPixel() const
+{
+    return this->_bitsPerPixel;
+}
+
+uint8_t IndexedPixelBuffer::IndexAt(uint16_t pixel) const
+{
+    if (pixel >= this->_count) { return 0; }
+
+    if (this->_bitsPerPixel == 8) { return this->_storage[pixel]; }
+
+    // Even pixels live in the high nibble.
+    uint8_t packed = this->_storage[pixel >> 1];
+    return pixel & 1 ? packed & 0x0F : packed >> 4;
+}
+
+PixelColor IndexedPixelBuffer::ColorAt(uint16_t pixel) const
+{
+    return PaletteColor(IndexAt(pixel));
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void IndexedPixelBuffer::SetIndex(uint16_t pixel, uint8_t index)
+{
+    if (pixel >= this->_count) { return; }
+
+    if (this->_bitsPerPixel == 8)
+    {
+        this->_storage[pixel] = index;
+        return;
+    }
+
+    uint8_t &packed = this->_storage[pixel >> 1];
+    packed = pixel & 1
+        ? (uint8_t)((packed & 0xF0) | (index & 0x0F))
+        : (uint8_t)((packed & 0x0F) | (index << 4));
+}
+
+void IndexedPixelBuffer::Fill(uint8_t index, uint16_t start, uint16_t end)
+{
+    if (end > this->_count) { end = this->_count; }
+    if (start >= end) { return; }
+
+    if (this->_bitsPerPixel == 8)
+    {
+        memset(this->_storage + start, index, end - start);
+        return;
+    }
+
+    // Set the odd edges one at a time and the whole bytes in between at once.
+    if (start & 1) { SetIndex(start++, index); }
+    if (end & 1) { SetIndex(--end, index); }
+    if (start < end)
+    {
+        uint8_t nibble = index & 0x0F;
+        memset(this->_storage + (start >> 1), (nibble << 4) | nibble, (end - start) >> 1);
+    }
+}
+
+void IndexedPixelBuffer::SetPalette(PixelColor *palette, uint16_t paletteSize)
+{
+    this->_palette = palette;
+    this->_paletteSize = palette != nullptr ? paletteSize : 0;
+}
+
+void IndexedPixelBuffer::SetPaletteColor(uint8_t index, const PixelColor &color)
+{
+    if (index >= this->_paletteSize) { return; }
+    this->_palette[index] = color;
+}
+
+void IndexedPixelBuffer::Expand(PixelColor *out, uint16_t start, uint16_t count) const
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        out[i] = PaletteColor(IndexAt(start + i));
+    }
+}
+
+void IndexedPixelBuffer::Pack(
+    uint32_t *out,
+    PixelType type,
+    uint32_t *packedPalette,
+    const PixelCorrection *correction) const
+{
+    Pack(out, 0, this->_count, type, packedPalette, correction);
+}
+
+void IndexedPixelBuffer::Pack(
+    uint32_t *out,
+    uint16_t start,
+    uint16_t count,
+    PixelType type,
+    uint32_t *packedPalette,
+    const PixelCorrection *correction) const
+{
+    if (start >= this->_count || count == 0) { return; }
+    if (count > this->_count - start) { count = this->_count - start; }
+    uint16_t end = start + count;
+
+    if (packedPalette == nullptr)
+    {
+        for (uint16_t i = start; i < end; i++)
+        {
+            PixelColor::PackStrip(&PaletteColor(IndexAt(i)), out++, 1, type, correction);
+        }
+        return;
+    }
+
+    // Pack each palette color once; every pixel is then a lookup. Indices past the
+    // palette map to black, which packs to zero (0) for every type.
+    uint16_t lookupSize = this->_bitsPerPixel == 4 ? 16 : 256;
+    PixelColor::PackStrip(
+        this->_palette,
+        packedPalette,
+        lookupSize < this->_paletteSize ? lookupSize : this->_paletteSize,
+        type,
+        correction);
+
+    if (this->_bitsPerPixel == 8)
+    {
+        for (uint16_t i = start; i < end; i++)
+        {
+            uint8_t index = this->_storage[i];
+            *out++ = index < this->_paletteSize ? packedPalette[index] : 0;
+        }
+        return;
+    }
+
+    // An odd start is the low nibble of its byte; after it, whole bytes hold two.
+    uint16_t i = start;
+    if (i & 1)
+    {
+        uint8_t low = this->_storage[i >> 1] & 0x0F;
+        *out++ = low < this->_paletteSize ? packedPalette[low] : 0;
+        i++;
+    }
+
+    for (; i < end; i += 2)
+    {
+        uint8_t packed = this->_storage[i >> 1];
+        uint8_t high = packed >> 4;
+        uint8_t low = packed & 0x0F;
+
+        *out++ = high < this->_paletteSize ? packedPalette[high] : 0;
+        if (i + 1 < end)
+        {
+            *out++ = low < this->_paletteSize ? packedPalette[low] : 0;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+const PixelColor& IndexedPixelBuffer::PaletteColor(uint8_t index) const
+{
+    return index < this->_paletteSize
+        ? this->_palette[index]
+        : IndexedPixelBufferHelpers::black;
+}
+
+// ------------------------------------------------------------------------------------
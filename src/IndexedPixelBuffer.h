@@ -0,0 +1,186 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    IndexedPixelBuffer.h
+  * @author  Naigon's Electronic Creations
+  * @brief   IndexedPixelBuffer
+  *          Strip buffer holding 4 or 8-bit palette indices instead of a PixelColor
+  *          per pixel, cutting strip memory to 1/8 or 1/4. A 300 pixel strip takes
+  *          150 bytes at 4 bits (16 colors) instead of 1200.
+  *
+  *          Colors are only expanded when the strip is packed for output. Changing a
+  *          palette entry recolors every pixel using it, at the cost of one entry.
+  *
+  *          Storage and palette are supplied by the caller; the buffer allocates
+  *          nothing.
+  *************************************************************************************
+**/
+
+#ifndef __IndexedPixelBuffer_H_
+#define __IndexedPixelBuffer_H_
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+class IndexedPixelBuffer
+{
+  public:
+    /**
+     * @brief   Bytes of storage needed for a buffer.
+     *
+     * @param   count
+     *          Number of pixels.
+     *
+     * @param   bitsPerPixel
+     *          4 or 8.
+     **/
+    static uint16_t StorageSize(uint16_t count, uint8_t bitsPerPixel);
+
+    /**
+     * @brief   Constructs a new instance of the IndexedPixelBuffer class. All pixels
+     *          are set to index zero (0).
+     *
+     * @param   storage
+     *          At least StorageSize(count, bitsPerPixel) bytes. Must outlive the
+     *          buffer.
+     *
+     * @param   count
+     *          Number of pixels.
+     *
+     * @param   bitsPerPixel
+     *          4 for up to 16 colors; 8 for up to 256. Any other value is treated as 8.
+     *
+     * @param   palette
+     *          Colors the indices refer to. Not copied.
+     *
+     * @param   paletteSize
+     *          Number of colors in palette. Indices at or past this read as black.
+     **/
+    IndexedPixelBuffer(
+        uint8_t *storage,
+        uint16_t count,
+        uint8_t bitsPerPixel,
+        PixelColor *palette,
+        uint16_t paletteSize);
+
+    /**
+     * @brief   Number of pixels.
+     **/
+    uint16_t Count() const;
+
+    /**
+     * @brief   Bits used per pixel; 4 or 8.
+     **/
+    uint8_t BitsPerPixel() const;
+
+    /**
+     * @brief   Palette index of a pixel.
+     **/
+    uint8_t IndexAt(uint16_t pixel) const;
+
+    /**
+     * @brief   Set the palette index of a pixel. With 4 bits per pixel only the low
+     *          nibble of index is used.
+     **/
+    void SetIndex(uint16_t pixel, uint8_t index);
+
+    /**
+     * @brief   Set pixels [start, end) to one palette index.
+     **/
+    void Fill(uint8_t index, uint16_t start = 0, uint16_t end = 0xFFFF);
+
+    /**
+     * @brief   The color a pixel currently shows.
+     **/
+    PixelColor ColorAt(uint16_t pixel) const;
+
+    /**
+     * @brief   Replace the whole palette, ie to switch blade color schemes.
+     **/
+    void SetPalette(PixelColor *palette, uint16_t paletteSize);
+
+    /**
+     * @brief   Change one palette color, recoloring every pixel that uses it.
+     **/
+    void SetPaletteColor(uint8_t index, const PixelColor &color);
+
+    /**
+     * @brief   Expand pixels to full colors, ie to feed a PixelCompositor layer.
+     *
+     * @param   out
+     *          Receives count pixels.
+     *
+     * @param   start
+     *          First pixel to expand.
+     *
+     * @param   count
+     *          Number of pixels to expand.
+     **/
+    void Expand(PixelColor *out, uint16_t start, uint16_t count) const;
+
+    /**
+     * @brief   Write the wire value of every pixel, as PixelColor::PackedValue would.
+     *          Needs 4 bytes of output per pixel; on AVR use the ranged overload.
+     *
+     * @param   out
+     *          Receives Count() packed values.
+     *
+     * @param   type
+     *          The pixel type used to construct the packing.
+     *
+     * @param   packedPalette
+     *          Optional scratch of one uint32_t per palette color. When supplied,
+     *          each palette color is packed once and pixels become a table lookup;
+     *          otherwise each pixel is packed individually to save the RAM.
+     *
+     * @param   correction
+     *          Optional white extraction and color correction. With packedPalette it
+     *          is applied once per palette color rather than once per pixel.
+     **/
+    void Pack(
+        uint32_t *out,
+        PixelType type,
+        uint32_t *packedPalette = nullptr,
+        const PixelCorrection *correction = nullptr) const;
+
+    /**
+     * @brief   Write the wire value of pixels [start, start + count), so the strip can
+     *          be streamed out through a small chunk buffer. This is the intended path
+     *          on AVR, where Count() packed values would not fit in RAM:
+     *
+     *          uint32_t chunk[16];
+     *          for (uint16_t i = 0; i < buffer.Count(); i += 16)
+     *          {
+     *              buffer.Pack(chunk, i, 16, type);
+     *              Send(chunk, min(16, buffer.Count() - i));
+     *          }
+     *
+     * @param   out
+     *          Receives count packed values; fewer if the range passes the last pixel.
+     *
+     * @param   packedPalette
+     *          As for the whole-strip Pack. The palette is packed again on every call,
+     *          so chunks should hold more pixels than the palette has colors.
+     **/
+    void Pack(
+        uint32_t *out,
+        uint16_t start,
+        uint16_t count,
+        PixelType type,
+        uint32_t *packedPalette = nullptr,
+        const PixelCorrection *correction = nullptr) const;
+
+  private:
+    const PixelColor& PaletteColor(uint8_t index) const;
+
+    uint8_t *_storage;
+    PixelColor *_palette;
+    uint16_t _count;
+    uint16_t _paletteSize;
+    uint8_t _bitsPerPixel;
+};
+
+#endif //__IndexedPixelBuffer_H_
@@ -4,6 +4,83 @@
 
 #include "MathUtils.h"
 
+namespace MathUtilsHelpers
+{
+    // First quarter of a sine wave, sin(2 * pi * k / 256) in Q15 for k = 0 to 64. The
+    // rest of the wave, and every FFT twiddle factor, comes from its symmetry.
+#ifdef __AVR__
+    const int16_t quarterSine[65] PROGMEM =
+#else
+    const int16_t quarterSine[65] =
+#endif
+    {
+        0, 804, 1608, 2411, 3212, 4011, 4808, 5602,
+        6393, 7180, 7962, 8740, 9512, 10279, 11039, 11793,
+        12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531,
+        18205, 18868, 19520, 20160, 20788, 21403, 22006, 22595,
+        23170, 23732, 24279, 24812, 25330, 25833, 26320, 26791,
+        27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957,
+        30274, 30572, 30853, 31114, 31357, 31581, 31786, 31972,
+        32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758,
+        32767
+    };
+
+    inline int16_t QuarterSine(uint8_t i)
+    {
+#ifdef __AVR__
+        return (int16_t)pgm_read_word(&quarterSine[i]);
+#else
+        return quarterSine[i];
+#endif
+    }
+
+    // sin(2 * pi * k / 256) in Q15.
+    int16_t Sin256(uint8_t k)
+    {
+        uint8_t i = k & 63;
+        switch (k >> 6)
+        {
+            case 0: return QuarterSine(i);
+            case 1: return QuarterSine(64 - i);
+            case 2: return -QuarterSine(i);
+            default: return -QuarterSine(64 - i);
+        }
+    }
+
+    // cos(2 * pi * k / 256) in Q15.
+    inline int16_t Cos256(uint8_t k)
+    {
+        return Sin256((uint8_t)(k + 64));
+    }
+
+    inline int16_t Saturate(int32_t value)
+    {
+        if (value > 32767) { return 32767; }
+        if (value < -32768) { return -32768; }
+        return (int16_t)value;
+    }
+
+    inline uint16_t Absolute(int16_t value)
+    {
+        return value < 0 ? (uint16_t)-(int32_t)value : (uint16_t)value;
+    }
+
+    inline bool IsFftSize(uint16_t n)
+    {
+        return n >= MathUtils_FftMinSize && n <= MathUtils_FftMaxSize && (n & (n - 1)) == 0;
+    }
+
+    // 2^(exponent / 256) * 256, using a quadratic fit for the fractional part.
+    uint32_t Exp2Q8(uint16_t exponent)
+    {
+        uint32_t f = exponent & 0xFF;
+        uint32_t mantissa = 256 + ((f * (168 + ((88 * f) >> 8))) >> 8);
+        return mantissa << (exponent >> 8);
+    }
+}
+
+using namespace MathUtilsHelpers;
+
 extern "C"
 {
     int32_t randomBetween(int32_t a, int32_t b)
@@ -25,4 +102,196 @@ extern "C"
     {
         return (float)random(1000) / 1000.0f;
     }
+
+    uint16_t fixedMagnitude2(int16_t x, int16_t y)
+    {
+        // Alpha max plus beta min, never below the larger component.
+        uint32_t a = Absolute(x);
+        uint32_t b = Absolute(y);
+        uint32_t high = a > b ? a : b;
+        uint32_t low = a > b ? b : a;
+        uint32_t estimate = (high * 123 + low * 51) >> 7;
+        return (uint16_t)(estimate > high ? estimate : high);
+    }
+
+    uint16_t fixedMagnitude3(int16_t x, int16_t y, int16_t z)
+    {
+        // Sorted components weighted (30 * high + 13 * middle + 9 * low) / 32, the
+        // minimax fit over the sphere for weights in 32nds. Finer weights gain little,
+        // ie 6.09% in 256ths.
+        uint32_t a = Absolute(x);
+        uint32_t b = Absolute(y);
+        uint32_t c = Absolute(z);
+        uint32_t t;
+        if (a < b) { t = a; a = b; b = t; }
+        if (b < c) { t = b; b = c; c = t; }
+        if (a < b) { t = a; a = b; b = t; }
+
+        uint32_t estimate = (a * 30 + b * 13 + c * 9) >> 5;
+        return estimate > 0xFFFF ? 0xFFFF : (uint16_t)estimate;
+    }
+
+    void fixedMagnitude3Batch(const int16_t *xyz, uint16_t *magnitudes, uint16_t count)
+    {
+        for (uint16_t i = 0; i < count; i++, xyz += 3)
+        {
+            magnitudes[i] = fixedMagnitude3(xyz[0], xyz[1], xyz[2]);
+        }
+    }
+
+    int8_t fixedWindowHann(int16_t *samples, uint16_t n)
+    {
+        if (!IsFftSize(n)) { return MathUtils_InvalidSize; }
+
+        // w = (1 - cos(2 * pi * i / n)) / 2, so the table index is exact for every size.
+        uint8_t step = (uint8_t)(256 / n);
+        for (uint16_t i = 0; i < n; i++)
+        {
+            int32_t weight = (32768 - (int32_t)Cos256((uint8_t)(i * step))) >> 1;
+            samples[i] = (int16_t)((samples[i] * weight) >> 15);
+        }
+
+        return 0;
+    }
+
+    int8_t fixedRealFft(int16_t *data, uint16_t n)
+    {
+        if (!IsFftSize(n)) { return MathUtils_InvalidSize; }
+
+        // The n real samples are treated as n/2 complex ones: data[2j] + i * data[2j + 1].
+        uint16_t m = n >> 1;
+
+        // Bit-reversed reordering of the complex samples.
+        for (uint16_t i = 1, j = 0; i < m; i++)
+        {
+            uint16_t bit = m >> 1;
+            for (; j & bit; bit >>= 1) { j ^= bit; }
+            j ^= bit;
+
+            if (i < j)
+            {
+                int16_t re = data[2 * i];
+                int16_t im = data[2 * i + 1];
+                data[2 * i] = data[2 * j];
+                data[2 * i + 1] = data[2 * j + 1];
+                data[2 * j] = re;
+                data[2 * j + 1] = im;
+            }
+        }
+
+        // Radix-2 decimation in time. Each stage halves its output, so the butterflies
+        // cannot overflow and the complex FFT comes out divided by m.
+        for (uint16_t length = 2; length <= m; length <<= 1)
+        {
+            uint16_t half = length >> 1;
+            uint8_t step = (uint8_t)(256 / length);
+
+            for (uint16_t j = 0; j < half; j++)
+            {
+                int32_t c = Cos256((uint8_t)(j * step));
+                int32_t s = Sin256((uint8_t)(j * step));
+
+                for (uint16_t i = j; i < m; i += length)
+                {
+                    int16_t *a = &data[2 * i];
+                    int16_t *b = &data[2 * (i + half)];
+
+                    // t = b * (c - i * s)
+                    int32_t tr = (b[0] * c + b[1] * s) >> 15;
+                    int32_t ti = (b[1] * c - b[0] * s) >> 15;
+
+                    b[0] = Saturate((a[0] - tr) >> 1);
+                    b[1] = Saturate((a[1] - ti) >> 1);
+                    a[0] = Saturate((a[0] + tr) >> 1);
+                    a[1] = Saturate((a[1] + ti) >> 1);
+                }
+            }
+        }
+
+        // Split the complex spectrum Z into the real spectrum X, halving once more:
+        //   X[k] = E + W^k * O, X[m - k] = conj(E - W^k * O)
+        // where E = (Z[k] + conj(Z[m - k])) / 2 and O = (Z[k] - conj(Z[m - k])) / 2i.
+        int16_t r0 = data[0];
+        int16_t i0 = data[1];
+        data[0] = (int16_t)(((int32_t)r0 + i0) >> 1);
+        data[1] = (int16_t)(((int32_t)r0 - i0) >> 1);
+
+        uint8_t step = (uint8_t)(256 / n);
+        for (uint16_t k = 1; k <= (m >> 1); k++)
+        {
+            int16_t *a = &data[2 * k];
+            int16_t *b = &data[2 * (m - k)];
+
+            // E and O at twice their value, to keep the low bit until the final shift.
+            int32_t er = (int32_t)a[0] + b[0];
+            int32_t ei = (int32_t)a[1] - b[1];
+            int32_t or_ = (int32_t)a[1] + b[1];
+            int32_t oi = (int32_t)b[0] - a[0];
+
+            // t = O * (c - i * s)
+            int32_t c = Cos256((uint8_t)(k * step));
+            int32_t s = Sin256((uint8_t)(k * step));
+            int32_t tr = (or_ * c + oi * s) >> 15;
+            int32_t ti = (oi * c - or_ * s) >> 15;
+
+            b[0] = Saturate((er - tr) >> 2);
+            b[1] = Saturate((ti - ei) >> 2);
+            a[0] = Saturate((er + tr) >> 2);
+            a[1] = Saturate((ei + ti) >> 2);
+        }
+
+        return 0;
+    }
+
+    void fixedFftMagnitudes(const int16_t *spectrum, uint16_t n, uint16_t *magnitudes)
+    {
+        // Bins are written in increasing order and bin k reads from 2k, so this also
+        // works in place.
+        magnitudes[0] = Absolute(spectrum[0]);
+        for (uint16_t k = 1; k < (n >> 1); k++)
+        {
+            magnitudes[k] = fixedMagnitude2(spectrum[2 * k], spectrum[2 * k + 1]);
+        }
+    }
+
+    int8_t fixedBandEnergies(
+        const uint16_t *magnitudes,
+        uint16_t binCount,
+        uint32_t *bands,
+        uint8_t bandCount)
+    {
+        if (binCount < 2 || (binCount & (binCount - 1)) != 0
+            || bandCount == 0 || bandCount >= binCount)
+        {
+            return MathUtils_InvalidSize;
+        }
+
+        uint8_t bits = 0;
+        while ((1u << bits) < binCount) { bits++; }
+
+        // Band b ends at bin 2^(bits * (b + 1) / bandCount), so the last band ends at
+        // binCount. Low bands are widened to one bin and high bands pulled in so every
+        // band keeps at least one.
+        uint16_t start = 1;
+        for (uint8_t b = 0; b < bandCount; b++)
+        {
+            uint16_t exponent = (uint16_t)(((uint32_t)bits * (b + 1) << 8) / bandCount);
+            uint32_t end = (Exp2Q8(exponent) + 128) >> 8;
+            uint16_t lastEnd = binCount - (bandCount - 1 - b);
+
+            if (end <= start) { end = start + 1; }
+            if (end > lastEnd) { end = lastEnd; }
+
+            uint32_t sum = 0;
+            for (uint16_t k = start; k < end; k++)
+            {
+                sum += ((uint32_t)magnitudes[k] * magnitudes[k]) >> 8;
+            }
+
+            bands[b] = sum / (end - start);
+            start = (uint16_t)end;
+        }
+
+        return 0;
+    }
 }
\ No newline at end of file
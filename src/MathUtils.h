@@ -7,7 +7,12 @@
   * @file    MathUtils.h
   * @author  Naigon's Electronic Creations
   * @brief   MathUtils
-  *          Math functionality wrappers
+  *          Math functionality wrappers, plus fixed-point signal processing for
+  *          sound-reactive effects: a radix-2 real FFT with precomputed twiddles,
+  *          windowing, magnitudes and log-spaced band energies. None of the signal
+  *          functions use floats, so they are usable on boards without an FPU.
+  *
+  *          Samples are Q15: int16_t where 32767 is just under 1.0.
   *************************************************************************************
 **/
 
@@ -19,6 +24,12 @@
 #define minimum(a, b) (a) < (b) ? a : b
 #define maximum(a, b) (a) > (b) ? a : b
 
+// Supported sizes for fixedRealFft.
+#define MathUtils_FftMinSize 64
+#define MathUtils_FftMaxSize 256
+
+#define MathUtils_InvalidSize -1
+
 extern "C"
 {
     /**
@@ -39,6 +50,104 @@ extern "C"
      * @brief   Returns a random value between [0, 1].
      **/
     float randomPercent();
+
+    /**
+     * @brief   Integer approximation of sqrt(x^2 + y^2), within 4.03%.
+     **/
+    uint16_t fixedMagnitude2(int16_t x, int16_t y);
+
+    /**
+     * @brief   Integer approximation of sqrt(x^2 + y^2 + z^2), within 6.25%: at worst
+     *          30/32 of the true value along an axis, and under 6% high elsewhere.
+     *          Useful on accelerometer and gyro vectors.
+     **/
+    uint16_t fixedMagnitude3(int16_t x, int16_t y, int16_t z);
+
+    /**
+     * @brief   fixedMagnitude3 of a burst of vectors, ie as read from a sensor FIFO.
+     *
+     * @param   xyz
+     *          count vectors stored x, y, z, x, y, z...
+     *
+     * @param   magnitudes
+     *          Receives count magnitudes.
+     *
+     * @param   count
+     *          Number of vectors.
+     **/
+    void fixedMagnitude3Batch(const int16_t *xyz, uint16_t *magnitudes, uint16_t count);
+
+    /**
+     * @brief   Applies a Hann window in place, to reduce leakage between FFT bins.
+     *
+     * @param   samples
+     *          Q15 samples.
+     *
+     * @param   n
+     *          Number of samples; a power of two from MathUtils_FftMinSize to
+     *          MathUtils_FftMaxSize.
+     *
+     * @return  Zero (0) on success; otherwise MathUtils_InvalidSize.
+     **/
+    int8_t fixedWindowHann(int16_t *samples, uint16_t n);
+
+    /**
+     * @brief   In-place FFT of n real Q15 samples. Computed as an n/2 point complex
+     *          FFT plus a split step, with every stage scaled by 1/2 so it cannot
+     *          overflow; the output is the true spectrum divided by n.
+     *
+     * @param   data
+     *          On input, n real samples. On output the packed spectrum:
+     *          data[0] = Re(bin 0), data[1] = Re(bin n/2), and for 0 < k < n/2
+     *          data[2k] = Re(bin k), data[2k + 1] = Im(bin k).
+     *
+     * @param   n
+     *          64, 128 or 256.
+     *
+     * @return  Zero (0) on success; otherwise MathUtils_InvalidSize.
+     **/
+    int8_t fixedRealFft(int16_t *data, uint16_t n);
+
+    /**
+     * @brief   Magnitude of each bin of a packed spectrum from fixedRealFft, using
+     *          fixedMagnitude2.
+     *
+     * @param   spectrum
+     *          Output of fixedRealFft.
+     *
+     * @param   n
+     *          The FFT size.
+     *
+     * @param   magnitudes
+     *          Receives n/2 magnitudes for bins 0 to n/2 - 1. May be the same memory
+     *          as spectrum.
+     **/
+    void fixedFftMagnitudes(const int16_t *spectrum, uint16_t n, uint16_t *magnitudes);
+
+    /**
+     * @brief   Groups bins into log-spaced bands, low to high, each holding the mean
+     *          power (magnitude squared / 256) of its bins. Bin 0 (DC) is skipped.
+     *          Every band holds at least one bin.
+     *
+     * @param   magnitudes
+     *          Output of fixedFftMagnitudes.
+     *
+     * @param   binCount
+     *          Number of magnitudes; a power of two.
+     *
+     * @param   bands
+     *          Receives bandCount values.
+     *
+     * @param   bandCount
+     *          Number of bands; at most binCount - 1.
+     *
+     * @return  Zero (0) on success; otherwise MathUtils_InvalidSize.
+     **/
+    int8_t fixedBandEnergies(
+        const uint16_t *magnitudes,
+        uint16_t binCount,
+        uint32_t *bands,
+        uint8_t bandCount);
 }
 
 #endif  //__MathUtils_H_
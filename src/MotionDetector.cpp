@@ -0,0 +1,148 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "MathUtils.h"
+#include "MotionDetector.h"
+
+namespace MotionDetectorHelpers
+{
+    inline int16_t Difference(int16_t a, int16_t b)
+    {
+        int32_t value = (int32_t)a - b;
+        if (value > 32767) { return 32767; }
+        if (value < -32768) { return -32768; }
+        return (int16_t)value;
+    }
+}
+
+MotionDetector::MotionDetector(
+    const BiquadCoefficients &swingSmoothing,
+    uint16_t swingThreshold,
+    uint16_t clashThreshold,
+    uint16_t clashHoldoffSamples)
+    : _swingCoefficients(swingSmoothing)
+    , _swingFilter(&_swingCoefficients, &_swingState, 1)
+    , _swingThreshold(swingThreshold)
+    , _clashThreshold(clashThreshold)
+    , _clashHoldoffSamples(clashHoldoffSamples)
+{
+    Reset();
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t MotionDetector::SwingSpeed() const
+{
+    return this->_swingSpeed < 0 ? 0 : (uint16_t)this->_swingSpeed;
+}
+
+bool MotionDetector::IsSwinging() const
+{
+    return this->_isSwinging;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+int8_t MotionDetector::RegisterCallback(void(*callback)(void *arg))
+{
+    return this->_callbackHandler.RegisterCallback(callback);
+}
+
+void MotionDetector::UnregisterCallback()
+{
+    this->_callbackHandler.UnregisterCallback();
+}
+
+void MotionDetector::SetThresholds(uint16_t swingThreshold, uint16_t clashThreshold)
+{
+    this->_swingThreshold = swingThreshold;
+    this->_clashThreshold = clashThreshold;
+}
+
+void MotionDetector::Reset()
+{
+    this->_swingFilter.Reset();
+    this->_clashHoldoff = 0;
+    this->_swingSpeed = 0;
+    this->_hasLastAccel = false;
+    this->_isSwinging = false;
+}
+
+uint8_t MotionDetector::Process(const int16_t *accel, const int16_t *gyro)
+{
+    return ProcessBatch(accel, gyro, 1);
+}
+
+uint8_t MotionDetector::ProcessBatch(const int16_t *accel, const int16_t *gyro, uint16_t count)
+{
+    uint8_t events = 0;
+    uint16_t speeds[MotionDetector_ChunkSize];
+
+    while (count > 0)
+    {
+        uint16_t chunk = count > MotionDetector_ChunkSize ? MotionDetector_ChunkSize : count;
+
+        // Magnitudes first, then smooth the whole chunk in one filter pass.
+        fixedMagnitude3Batch(gyro, speeds, chunk);
+        int16_t *smoothed = (int16_t *)speeds;
+        for (uint16_t i = 0; i < chunk; i++)
+        {
+            smoothed[i] = speeds[i] > 32767 ? 32767 : (int16_t)speeds[i];
+        }
+        this->_swingFilter.ProcessBatch(smoothed, smoothed, chunk);
+
+        for (uint16_t i = 0; i < chunk; i++, accel += 3)
+        {
+            this->_swingSpeed = smoothed[i];
+            if (!this->_isSwinging && this->_swingSpeed >= (int32_t)this->_swingThreshold)
+            {
+                this->_isSwinging = true;
+                events |= MotionDetector_Swing;
+            }
+            else if (this->_isSwinging
+                && this->_swingSpeed < (int32_t)((this->_swingThreshold * 3UL) >> 2))
+            {
+                this->_isSwinging = false;
+            }
+
+            if (this->_clashHoldoff > 0)
+            {
+                this->_clashHoldoff--;
+            }
+            else if (this->_hasLastAccel)
+            {
+                uint16_t jerk = fixedMagnitude3(
+                    MotionDetectorHelpers::Difference(accel[0], this->_lastAccel[0]),
+                    MotionDetectorHelpers::Difference(accel[1], this->_lastAccel[1]),
+                    MotionDetectorHelpers::Difference(accel[2], this->_lastAccel[2]));
+
+                if (jerk >= this->_clashThreshold)
+                {
+                    this->_clashHoldoff = this->_clashHoldoffSamples;
+                    events |= MotionDetector_Clash;
+                }
+            }
+
+            this->_lastAccel[0] = accel[0];
+            this->_lastAccel[1] = accel[1];
+            this->_lastAccel[2] = accel[2];
+            this->_hasLastAccel = true;
+        }
+
+        gyro += 3 * chunk;
+        count -= chunk;
+    }
+
+    if (events != 0) { this->_callbackHandler.FireCallback(&events); }
+    return events;
+}
+
+// ------------------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    MotionDetector.h
+  * @author  Naigon's Electronic Creations
+  * @brief   MotionDetector
+  *          Swing and clash detection from raw IMU samples, in integer math only.
+  *
+  *          Swing  - the gyro magnitude, smoothed by a low-pass biquad, rising past a
+  *                   threshold. It re-arms once the speed falls below 3/4 of it.
+  *          Clash  - the change in acceleration between two samples (jerk) reaching
+  *                   a threshold, then ignored for a holdoff so one hit fires once.
+  *
+  *          Samples can be fed one at a time or as a whole sensor FIFO burst. The
+  *          registered callback fires once per call that detected anything, with a
+  *          pointer to a uint8_t of MotionDetector_Swing | MotionDetector_Clash flags.
+  *************************************************************************************
+**/
+
+#ifndef __MotionDetector_H_
+#define __MotionDetector_H_
+
+#include "Arduino.h"
+#include "CallbackHandler.h"
+#include "FixedFilter.h"
+#include "ICallbackHandler.h"
+
+#define MotionDetector_Swing 0x01
+#define MotionDetector_Clash 0x02
+
+// Samples handled per pass of ProcessBatch; bounds its stack use.
+#define MotionDetector_ChunkSize 16
+
+class MotionDetector : public ICallbackHandler
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the MotionDetector class.
+     *
+     * @param   swingSmoothing
+     *          Low-pass applied to the gyro magnitude, ie
+     *          BiquadCascade::LowPass(10, sampleRateHz). Copied.
+     *
+     * @param   swingThreshold
+     *          Smoothed gyro magnitude, in raw sensor units, that starts a swing.
+     *
+     * @param   clashThreshold
+     *          Change in acceleration between samples, in raw sensor units, that is a
+     *          clash.
+     *
+     * @param   clashHoldoffSamples
+     *          Samples after a clash during which another is not reported.
+     **/
+    MotionDetector(
+        const BiquadCoefficients &swingSmoothing,
+        uint16_t swingThreshold,
+        uint16_t clashThreshold,
+        uint16_t clashHoldoffSamples);
+
+    // The swing filter points into this object, so a copy would share its state.
+    MotionDetector(const MotionDetector&) = delete;
+    MotionDetector& operator=(const MotionDetector&) = delete;
+
+    // -------------------------------------------------------------------------------
+    // ICallbackHandler methods. See ICallbackHandler.h for method details.
+    // -------------------------------------------------------------------------------
+    int8_t RegisterCallback(void(*callback)(void *arg));
+    void UnregisterCallback();
+
+    /**
+     * @brief   Changes the detection thresholds, ie for a sensitivity setting.
+     **/
+    void SetThresholds(uint16_t swingThreshold, uint16_t clashThreshold);
+
+    /**
+     * @brief   Clears the filter history and any swing or clash in progress.
+     **/
+    void Reset();
+
+    /**
+     * @brief   Processes one sample.
+     *
+     * @param   accel
+     *          Accelerometer x, y, z.
+     *
+     * @param   gyro
+     *          Gyro x, y, z.
+     *
+     * @return  MotionDetector_Swing and/or MotionDetector_Clash if either started on
+     *          this sample; otherwise zero (0).
+     **/
+    uint8_t Process(const int16_t *accel, const int16_t *gyro);
+
+    /**
+     * @brief   Processes a burst of samples, ie a whole sensor FIFO.
+     *
+     * @param   accel
+     *          count accelerometer samples stored x, y, z, x, y, z...
+     *
+     * @param   gyro
+     *          count gyro samples in the same layout.
+     *
+     * @param   count
+     *          Number of samples.
+     *
+     * @return  The flags of every swing or clash that started within the burst.
+     **/
+    uint8_t ProcessBatch(const int16_t *accel, const int16_t *gyro, uint16_t count);
+
+    /**
+     * @brief   Smoothed gyro magnitude as of the last sample, ie to drive hum pitch.
+     **/
+    uint16_t SwingSpeed() const;
+
+    /**
+     * @brief   True while a swing is in progress.
+     **/
+    bool IsSwinging() const;
+
+  private:
+    CallbackHandler _callbackHandler;
+    BiquadCoefficients _swingCoefficients;
+    BiquadState _swingState;
+    BiquadCascade _swingFilter;
+    int16_t _lastAccel[3];
+    uint16_t _swingThreshold;
+    uint16_t _clashThreshold;
+    uint16_t _clashHoldoffSamples;
+    uint16_t _clashHoldoff;
+    int16_t _swingSpeed;
+    bool _hasLastAccel;
+    bool _isSwinging;
+};
+
+#endif //__MotionDetector_H_
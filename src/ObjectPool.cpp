@@ -0,0 +1,128 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "ObjectPool.h"
+
+#define ObjectPool_EndOfList 0xFFFF
+
+namespace ObjectPoolHelpers
+{
+    // The next free index is kept in the first two bytes of a free block. Blocks may
+    // only be byte aligned, so go through memcpy.
+    inline uint16_t NextFree(const uint8_t *block)
+    {
+        uint16_t next;
+        memcpy(&next, block, sizeof(next));
+        return next;
+    }
+
+    inline void SetNextFree(uint8_t *block, uint16_t next)
+    {
+        memcpy(block, &next, sizeof(next));
+    }
+}
+
+ObjectPool::ObjectPool(void *storage, uint16_t blockSize, uint16_t blockCount)
+    : _storage((uint8_t *)storage)
+    , _blockSize(blockSize < 2 ? 2 : blockSize)
+    , _blockCount(blockCount == ObjectPool_EndOfList ? blockCount - 1 : blockCount)
+    , _highWaterMark(0)
+    , _failedCount(0)
+{
+    Reset();
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t ObjectPool::BlockSize() const
+{
+    return this->_blockSize;
+}
+
+uint16_t ObjectPool::Capacity() const
+{
+    return this->_blockCount;
+}
+
+uint16_t ObjectPool::InUse() const
+{
+    return this->_inUse;
+}
+
+uint16_t ObjectPool::HighWaterMark() const
+{
+    return this->_highWaterMark;
+}
+
+uint16_t ObjectPool::FailedCount() const
+{
+    return this->_failedCount;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void *ObjectPool::Allocate()
+{
+    if (this->_freeHead == ObjectPool_EndOfList)
+    {
+        this->_failedCount++;
+        return nullptr;
+    }
+
+    uint8_t *block = this->_storage + (uint32_t)this->_freeHead * this->_blockSize;
+    this->_freeHead = ObjectPoolHelpers::NextFree(block);
+
+    if (++this->_inUse > this->_highWaterMark) { this->_highWaterMark = this->_inUse; }
+
+    return block;
+}
+
+bool ObjectPool::Free(void *block)
+{
+    if (!Owns(block)) { return false; }
+
+    uint16_t index = (uint16_t)(((uint8_t *)block - this->_storage) / this->_blockSize);
+    ObjectPoolHelpers::SetNextFree((uint8_t *)block, this->_freeHead);
+    this->_freeHead = index;
+    this->_inUse--;
+
+    return true;
+}
+
+bool ObjectPool::Owns(const void *block) const
+{
+    if (block == nullptr || (const uint8_t *)block < this->_storage) { return false; }
+
+    uint32_t offset = (uint32_t)((const uint8_t *)block - this->_storage);
+    return offset < (uint32_t)this->_blockCount * this->_blockSize
+        && offset % this->_blockSize == 0;
+}
+
+void ObjectPool::Reset()
+{
+    // Chain the blocks in address order so a fresh pool hands them out sequentially.
+    for (uint16_t i = 0; i < this->_blockCount; i++)
+    {
+        uint16_t next = i + 1 < this->_blockCount ? i + 1 : ObjectPool_EndOfList;
+        ObjectPoolHelpers::SetNextFree(this->_storage + (uint32_t)i * this->_blockSize, next);
+    }
+
+    this->_freeHead = this->_blockCount > 0 ? 0 : ObjectPool_EndOfList;
+    this->_inUse = 0;
+}
+
+void ObjectPool::ResetStatistics()
+{
+    this->_highWaterMark = this->_inUse;
+    this->_failedCount = 0;
+}
+
+// ------------------------------------------------------------------------------------
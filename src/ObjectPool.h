@@ -0,0 +1,151 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    ObjectPool.h
+  * @author  Naigon's Electronic Creations
+  * @brief   ObjectPool
+  *          Fixed-size block allocator over static storage, for event payloads,
+  *          effect instances and anything else that would otherwise be new'ed at
+  *          runtime. Allocate and Free are O(1), and since every block is the same
+  *          size the pool can never fragment.
+  *
+  *          Free blocks form a linked list threaded through the blocks themselves,
+  *          so the pool has no per-block overhead; blocks are at least 2 bytes.
+  *
+  *          HighWaterMark and FailedCount report how close a pool came to running
+  *          out, ie to size it from a test session.
+  *
+  *          Blocks are raw memory; objects with constructors must be constructed in
+  *          place by the caller.
+  *************************************************************************************
+**/
+
+#ifndef __ObjectPool_H_
+#define __ObjectPool_H_
+
+#include "Arduino.h"
+
+class ObjectPool
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the ObjectPool class with every block
+     *          free.
+     *
+     * @param   storage
+     *          blockSize * blockCount bytes, aligned for whatever the blocks hold.
+     *          Must outlive the pool.
+     *
+     * @param   blockSize
+     *          Size of each block in bytes; at least 2, and a multiple of the
+     *          alignment needed by the blocks' contents.
+     *
+     * @param   blockCount
+     *          Number of blocks; less than 0xFFFF.
+     **/
+    ObjectPool(void *storage, uint16_t blockSize, uint16_t blockCount);
+
+    /**
+     * @brief   Takes a free block.
+     *
+     * @return  The block; or nullptr if every block is in use.
+     **/
+    void *Allocate();
+
+    /**
+     * @brief   Returns a block to the pool. Freeing a block twice is not detected.
+     *
+     * @return  True if the block was returned; false if it is nullptr or did not come
+     *          from this pool.
+     **/
+    bool Free(void *block);
+
+    /**
+     * @brief   Whether the pointer is the start of one of this pool's blocks.
+     **/
+    bool Owns(const void *block) const;
+
+    /**
+     * @brief   Returns every block to the pool at once. Statistics are kept.
+     **/
+    void Reset();
+
+    /**
+     * @brief   Size of each block in bytes.
+     **/
+    uint16_t BlockSize() const;
+
+    /**
+     * @brief   Total number of blocks.
+     **/
+    uint16_t Capacity() const;
+
+    /**
+     * @brief   Number of blocks currently allocated.
+     **/
+    uint16_t InUse() const;
+
+    /**
+     * @brief   Most blocks that have been allocated at once.
+     **/
+    uint16_t HighWaterMark() const;
+
+    /**
+     * @brief   Number of Allocate calls that failed because the pool was empty.
+     **/
+    uint16_t FailedCount() const;
+
+    /**
+     * @brief   Restarts HighWaterMark from the current use and FailedCount from zero.
+     **/
+    void ResetStatistics();
+
+  private:
+    uint8_t *_storage;
+    uint16_t _blockSize;
+    uint16_t _blockCount;
+    uint16_t _freeHead;
+    uint16_t _inUse;
+    uint16_t _highWaterMark;
+    uint16_t _failedCount;
+};
+
+/**
+ * @brief   ObjectPool with its own storage, sized and aligned for Count objects of
+ *          type T. Typically declared as a global:
+ *
+ *          StaticObjectPool<ClashEvent, 4> clashPool;
+ *          ClashEvent *event = clashPool.Allocate();
+ **/
+template <typename T, uint16_t Count>
+class StaticObjectPool : public ObjectPool
+{
+  public:
+    StaticObjectPool()
+        : ObjectPool(_blocks, PaddedSize, Count)
+    {
+    }
+
+    // The base points at _blocks, so a copy would hand out the original's blocks.
+    StaticObjectPool(const StaticObjectPool&) = delete;
+    StaticObjectPool& operator=(const StaticObjectPool&) = delete;
+
+    /**
+     * @brief   Takes a free block typed as T. Its contents are not initialized.
+     **/
+    T *Allocate()
+    {
+        return static_cast<T *>(ObjectPool::Allocate());
+    }
+
+  private:
+    static constexpr uint16_t PaddedSize =
+        ((sizeof(T) < 2 ? 2 : sizeof(T)) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    alignas(T) uint8_t _blocks[PaddedSize * Count];
+};
+
+#endif //__ObjectPool_H_
@@ -0,0 +1,139 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "ParallelStripEncoder.h"
+
+namespace ParallelStripEncoderHelpers
+{
+    /**
+     * 8x8 bit matrix transpose (Hacker's Delight, transpose8rS32) using only 32-bit
+     * operations so it stays cheap on 8-bit cores.
+     *
+     * in[n] is the wire byte of lane n. out[j * stride] receives wire bit j (0 being
+     * the most significant) of every lane, with lane n on bit n.
+     **/
+    inline void Transpose8(const uint8_t *in, uint8_t *out, uint8_t stride)
+    {
+        // Rows are loaded highest lane first so lane n ends up on output bit n.
+        uint32_t x = ((uint32_t)in[7] << 24) | ((uint32_t)in[6] << 16) | ((uint32_t)in[5] << 8) | in[4];
+        uint32_t y = ((uint32_t)in[3] << 24) | ((uint32_t)in[2] << 16) | ((uint32_t)in[1] << 8) | in[0];
+        uint32_t t;
+
+        t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+        t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+
+        t = (x ^ (x >> 14)) & 0x0000CCCC;  x = x ^ t ^ (t << 14);
+        t = (y ^ (y >> 14)) & 0x0000CCCC;  y = y ^ t ^ (t << 14);
+
+        t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+        y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+        x = t;
+
+        out[0] = (uint8_t)(x >> 24);
+        out[stride] = (uint8_t)(x >> 16);
+        out[2 * stride] = (uint8_t)(x >> 8);
+        out[3 * stride] = (uint8_t)x;
+        out[4 * stride] = (uint8_t)(y >> 24);
+        out[5 * stride] = (uint8_t)(y >> 16);
+        out[6 * stride] = (uint8_t)(y >> 8);
+        out[7 * stride] = (uint8_t)y;
+    }
+}
+
+uint8_t ParallelStripEncoder::BytesPerPixel(PixelType type)
+{
+    return type == PixelType::SK6812_RGBW ? 4 : 3;
+}
+
+uint32_t ParallelStripEncoder::EncodedLength(uint16_t pixelCount, PixelType type)
+{
+    return (uint32_t)pixelCount * BytesPerPixel(type) * 8;
+}
+
+void ParallelStripEncoder::Encode8(
+    const uint32_t *const *lanes,
+    const uint16_t *laneLengths,
+    uint8_t laneCount,
+    uint16_t start,
+    uint16_t count,
+    PixelType type,
+    uint8_t *out)
+{
+    if (laneCount > 8) { laneCount = 8; }
+    EncodeGroup(lanes, laneLengths, laneCount, start, count, BytesPerPixel(type), out, 1);
+}
+
+void ParallelStripEncoder::Encode16(
+    const uint32_t *const *lanes,
+    const uint16_t *laneLengths,
+    uint8_t laneCount,
+    uint16_t start,
+    uint16_t count,
+    PixelType type,
+    uint16_t *out)
+{
+    if (laneCount > 16) { laneCount = 16; }
+
+    // Each 16-bit word is two independent 8-lane bytes: lanes 0-7 in the low byte and
+    // lanes 8-15 in the high byte. Write them in place with a stride of two bytes.
+    uint8_t bytesPerPixel = BytesPerPixel(type);
+    uint8_t *bytes = (uint8_t *)out;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint8_t *low = bytes + 1;
+    uint8_t *high = bytes;
+#else
+    uint8_t *low = bytes;
+    uint8_t *high = bytes + 1;
+#endif
+
+    bool hasHigh = laneCount > 8;
+    EncodeGroup(lanes, laneLengths, hasHigh ? 8 : laneCount, start, count, bytesPerPixel, low, 2);
+    EncodeGroup(
+        hasHigh ? lanes + 8 : lanes,
+        hasHigh && laneLengths != nullptr ? laneLengths + 8 : nullptr,
+        hasHigh ? laneCount - 8 : 0,
+        start,
+        count,
+        bytesPerPixel,
+        high,
+        2);
+}
+
+void ParallelStripEncoder::EncodeGroup(
+    const uint32_t *const *lanes,
+    const uint16_t *laneLengths,
+    uint8_t laneCount,
+    uint16_t start,
+    uint16_t count,
+    uint8_t bytesPerPixel,
+    uint8_t *out,
+    uint8_t stride)
+{
+    uint8_t wireBytes[4][8];
+    memset(wireBytes, 0, sizeof(wireBytes));
+
+    uint32_t end = (uint32_t)start + count;
+    for (uint32_t p = start; p < end; p++)
+    {
+        // Gather this pixel's wire bytes from every lane; missing or finished lanes
+        // stay zero.
+        for (uint8_t lane = 0; lane < laneCount; lane++)
+        {
+            bool hasPixel = lanes[lane] != nullptr
+                && (laneLengths == nullptr || p < laneLengths[lane]);
+            uint32_t value = hasPixel ? lanes[lane][p] : 0;
+
+            wireBytes[0][lane] = (uint8_t)(value >> 24);
+            wireBytes[1][lane] = (uint8_t)(value >> 16);
+            wireBytes[2][lane] = (uint8_t)(value >> 8);
+            wireBytes[3][lane] = (uint8_t)value;
+        }
+
+        for (uint8_t b = 0; b < bytesPerPixel; b++)
+        {
+            ParallelStripEncoderHelpers::Transpose8(wireBytes[b], out, stride);
+            out += 8 * stride;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    ParallelStripEncoder.h
+  * @author  Naigon's Electronic Creations
+  * @brief   ParallelStripEncoder
+  *          Turns up to 8 (or 16) strips of packed pixel values into one port-parallel
+  *          bit stream. Each output byte (or 16-bit word) holds the same wire bit of
+  *          every strip, with strip n on port bit n, so writing the stream to a GPIO
+  *          port, by bit-bang or DMA, updates all strips at once in the time of one.
+  *
+  *          Input is what PixelColor::PackedValue or PackStrip produce: the first wire
+  *          byte in bits 31..24, then 23..16, 15..8 and, for RGBW, 7..0. Bits are sent
+  *          most significant first, so a pixel becomes 24 output entries (32 for RGBW).
+  *
+  *          Strips may differ in length; a strip that has ended sends zero bits, which
+  *          the LEDs after its last one never see.
+  *
+  *          This is a pure kernel: it does no I/O and allocates nothing.
+  *************************************************************************************
+**/
+
+#ifndef __ParallelStripEncoder_H_
+#define __ParallelStripEncoder_H_
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+class ParallelStripEncoder
+{
+  public:
+    /**
+     * @brief   Wire bytes per pixel for a type; 4 for SK6812_RGBW, otherwise 3.
+     **/
+    static uint8_t BytesPerPixel(PixelType type);
+
+    /**
+     * @brief   Output entries (bytes for Encode8, words for Encode16) needed for
+     *          the given number of pixels.
+     **/
+    static uint32_t EncodedLength(uint16_t pixelCount, PixelType type);
+
+    /**
+     * @brief   Encode pixels [start, start + count) of up to 8 strips.
+     *
+     * @param   lanes
+     *          Packed values of each strip; lanes[n] is sent on port bit n. A nullptr
+     *          lane sends zero bits.
+     *
+     * @param   laneLengths
+     *          Pixel count of each strip, or nullptr if every strip is at least
+     *          start + count pixels long.
+     *
+     * @param   laneCount
+     *          Number of strips; 1 to 8.
+     *
+     * @param   start
+     *          First pixel to encode, so a long frame can be encoded in chunks as the
+     *          output consumes it.
+     *
+     * @param   count
+     *          Number of pixels to encode.
+     *
+     * @param   type
+     *          Pixel type of all strips.
+     *
+     * @param   out
+     *          Receives EncodedLength(count, type) bytes.
+     **/
+    static void Encode8(
+        const uint32_t *const *lanes,
+        const uint16_t *laneLengths,
+        uint8_t laneCount,
+        uint16_t start,
+        uint16_t count,
+        PixelType type,
+        uint8_t *out);
+
+    /**
+     * @brief   Encode up to 16 strips into 16-bit port words. Parameters are the same
+     *          as Encode8, with laneCount from 1 to 16 and EncodedLength(count, type)
+     *          words of output.
+     **/
+    static void Encode16(
+        const uint32_t *const *lanes,
+        const uint16_t *laneLengths,
+        uint8_t laneCount,
+        uint16_t start,
+        uint16_t count,
+        PixelType type,
+        uint16_t *out);
+
+  private:
+    static void EncodeGroup(
+        const uint32_t *const *lanes,
+        const uint16_t *laneLengths,
+        uint8_t laneCount,
+        uint16_t start,
+        uint16_t count,
+        uint8_t bytesPerPixel,
+        uint8_t *out,
+        uint8_t stride);
+};
+
+#endif //__ParallelStripEncoder_H_
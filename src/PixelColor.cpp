@@ -6,29 +6,6 @@ const uint8_t shift_WS2813[]      = { 16, 24, 8, 0 };
 const uint8_t shift_SK6812[]      = { 16, 24, 8, 0 };
 const uint8_t shift_SK6812_RGBW[] = { 24, 16, 8, 0 };
 
-PixelColor::PixelColor()
-    : PixelColor(0, 0, 0, 0)
-{
-}
-
-PixelColor::PixelColor(uint8_t red, uint8_t green, uint8_t blue)
-    : PixelColor(red, green, blue, 0)
-{
-}
-
-PixelColor::PixelColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
-    : _r(red)
-    , _g(green)
-    , _b(blue)
-    , _w(white)
-{
-}
-
-uint8_t PixelColor::Red() const { return this->_r; }
-uint8_t PixelColor::Green() const { return this->_g; }
-uint8_t PixelColor::Blue() const { return this->_b; }
-uint8_t PixelColor::White() const { return this->_w; }
-
 void PixelColor::SetRed(uint8_t red) { this->_r = red; }
 void PixelColor::SetGreen(uint8_t green) { this->_g = green; }
 void PixelColor::SetBlue(uint8_t blue) { this->_b = blue; }
@@ -107,7 +84,86 @@ uint32_t PixelColor::PackedValue(PixelType type) const
     return result;
 }
 
-const uint8_t* PixelColor::GetShiftArray(PixelType type) const
+uint32_t PixelColor::PackedValue(PixelType type, const PixelCorrection &correction) const
+{
+    uint32_t result;
+    PackStrip(this, &result, 1, type, &correction);
+    return result;
+}
+
+void PixelColor::PackStrip(
+    const PixelColor *pixels,
+    uint32_t *out,
+    uint16_t count,
+    PixelType type,
+    const PixelCorrection *correction)
+{
+    // Resolve everything that depends only on the type once for the whole strip.
+    const uint8_t *shiftArray = GetShiftArray(type);
+    bool isRGBW = type == PixelType::SK6812_RGBW;
+    bool isGR = type == PixelType::WS2812b_GR || type == PixelType::SK6812_GR;
+
+    uint8_t shiftRed = shiftArray[isGR ? 1 : 0];
+    uint8_t shiftGreen = shiftArray[isGR ? 0 : 1];
+    uint8_t shiftBlue = shiftArray[2];
+    uint8_t shiftWhite = shiftArray[3];
+
+    if (correction == nullptr)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            const PixelColor &p = pixels[i];
+            out[i] =
+                ((uint32_t)p._r << shiftRed) |
+                ((uint32_t)p._g << shiftGreen) |
+                ((uint32_t)p._b << shiftBlue) |
+                ((uint32_t)(isRGBW ? p._w : 0) << shiftWhite);
+        }
+        return;
+    }
+
+    WhiteExtraction extraction = isRGBW ? correction->whiteExtraction : WhiteExtraction::WhitePassthrough;
+    uint16_t scaleRed = correction->redScale;
+    uint16_t scaleGreen = correction->greenScale;
+    uint16_t scaleBlue = correction->blueScale;
+    uint16_t scaleWhite = isRGBW ? correction->whiteScale : 0;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const PixelColor &p = pixels[i];
+        uint16_t r = p._r;
+        uint16_t g = p._g;
+        uint16_t b = p._b;
+        uint16_t w = p._w;
+
+        if (extraction != WhiteExtraction::WhitePassthrough)
+        {
+            uint16_t shared = r < g ? r : g;
+            shared = shared < b ? shared : b;
+
+            w += shared;
+            if (extraction == WhiteExtraction::WhiteReplace)
+            {
+                r -= shared;
+                g -= shared;
+                b -= shared;
+            }
+        }
+
+        r = (uint16_t)(((uint32_t)r * scaleRed) >> 8);
+        g = (uint16_t)(((uint32_t)g * scaleGreen) >> 8);
+        b = (uint16_t)(((uint32_t)b * scaleBlue) >> 8);
+        w = (uint16_t)(((uint32_t)w * scaleWhite) >> 8);
+
+        out[i] =
+            ((uint32_t)(r > 255 ? 255 : r) << shiftRed) |
+            ((uint32_t)(g > 255 ? 255 : g) << shiftGreen) |
+            ((uint32_t)(b > 255 ? 255 : b) << shiftBlue) |
+            ((uint32_t)(w > 255 ? 255 : w) << shiftWhite);
+    }
+}
+
+const uint8_t* PixelColor::GetShiftArray(PixelType type)
 {
     switch(type)
     {
@@ -9,6 +9,9 @@
   * @brief   PixelColor
   *          Definition for a single pixel color of a blade. It can represent the
   *          entire blade in the case of in-hilt LED blades.
+  *
+  *          PixelColor is a literal type: colors declared constexpr, or in a
+  *          PixelColorTable, are built by the compiler and cost no startup work.
   *************************************************************************************
 **/
 
@@ -36,6 +39,37 @@ enum PixelType : uint8_t
     Standard = 6,
 };
 
+// How the white channel is produced when packing for SK6812_RGBW. Other pixel types
+// have no white channel and ignore this.
+enum WhiteExtraction : uint8_t
+{
+    // Send the stored white value as is.
+    WhitePassthrough = 0,
+
+    // Move the white shared by red, green and blue (their minimum) into the white
+    // channel. Same color, but driven by the white LED.
+    WhiteReplace = 1,
+
+    // Add the shared white to the white channel but keep red, green and blue; brighter
+    // and less saturated.
+    WhiteBoost = 2,
+};
+
+// Adjustments applied while packing, in one pass with no floats.
+struct PixelCorrection
+{
+    WhiteExtraction whiteExtraction;
+
+    // Per channel scale where 256 is unchanged, ie to correct an LED's color
+    // temperature. Results above 255 saturate.
+    uint16_t redScale;
+    uint16_t greenScale;
+    uint16_t blueScale;
+    uint16_t whiteScale;
+};
+
+#define PixelCorrection_Unity 256
+
 class PixelColor
 {
 public:
@@ -43,37 +77,49 @@ public:
      * @brief   Constructs a new instance of the PixelColor class, with all colors set
      *          to zero (0).
      **/
-    PixelColor();
+    constexpr PixelColor()
+        : PixelColor(0, 0, 0, 0)
+    {
+    }
 
     /**
      * @brief   Constructs a new instance of the PixelColor class with RGB data.
      **/
-    PixelColor(uint8_t red, uint8_t green, uint8_t blue);
+    constexpr PixelColor(uint8_t red, uint8_t green, uint8_t blue)
+        : PixelColor(red, green, blue, 0)
+    {
+    }
 
     /**
      * @brief   Constructs a new instance of the PIxelColor class with RGBW data.
      **/
-    PixelColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t white);
+    constexpr PixelColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+        : _r(red)
+        , _g(green)
+        , _b(blue)
+        , _w(white)
+    {
+    }
 
     /**
      * @brief   Red value.
      **/
-    uint8_t Red() const;
+    constexpr uint8_t Red() const { return _r; }
 
     /**
      * @brief   Green value.
      **/
-    uint8_t Green() const;
+    constexpr uint8_t Green() const { return _g; }
 
     /**
      * @brief   Blue value.
      **/
-    uint8_t Blue() const;
+    constexpr uint8_t Blue() const { return _b; }
 
     /**
      * @brief   White value.
      **/
-    uint8_t White() const;
+    constexpr uint8_t White() const { return _w; }
 
     /**
      * @brief   Set the red value with new color red.
@@ -165,8 +211,46 @@ public:
      **/
     uint32_t PackedValue(PixelType type) const;
 
+    /**
+     * @brief   32-bit packed color value after white extraction and color correction.
+     *          The color itself is not modified.
+     *
+     * @param   type
+     *          The pixel type used to construct the packing.
+     *
+     * @param   correction
+     *          Adjustments to apply while packing.
+     **/
+    uint32_t PackedValue(PixelType type, const PixelCorrection &correction) const;
+
+    /**
+     * @brief   Pack a whole strip into wire values in one pass, applying the optional
+     *          correction to each pixel on the way.
+     *
+     * @param   pixels
+     *          Source colors.
+     *
+     * @param   out
+     *          Receives count packed values.
+     *
+     * @param   count
+     *          Number of pixels.
+     *
+     * @param   type
+     *          The pixel type used to construct the packing.
+     *
+     * @param   correction
+     *          Adjustments to apply, or nullptr to pack the colors as they are.
+     **/
+    static void PackStrip(
+        const PixelColor *pixels,
+        uint32_t *out,
+        uint16_t count,
+        PixelType type,
+        const PixelCorrection *correction = nullptr);
+
 private:
-    const uint8_t* GetShiftArray(PixelType type) const;
+    static const uint8_t* GetShiftArray(PixelType type);
     uint8_t _r, _g, _b, _w;
 };
 
@@ -0,0 +1,32 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "PixelColorTable.h"
+
+PixelColor PixelColorTable::At(uint16_t index) const
+{
+    if (index >= this->_count) { return PixelColor(); }
+
+#ifdef __AVR__
+    PixelColor color;
+    memcpy_P(&color, &this->_colors[index], sizeof(PixelColor));
+    return color;
+#else
+    return this->_colors[index];
+#endif
+}
+
+uint16_t PixelColorTable::CopyTo(PixelColor *out, uint16_t start, uint16_t count) const
+{
+    if (start >= this->_count) { return 0; }
+    if (count > this->_count - start) { count = this->_count - start; }
+
+#ifdef __AVR__
+    memcpy_P(out, &this->_colors[start], (size_t)count * sizeof(PixelColor));
+#else
+    memcpy(out, &this->_colors[start], (size_t)count * sizeof(PixelColor));
+#endif
+
+    return count;
+}
@@ -0,0 +1,93 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    PixelColorTable.h
+  * @author  Naigon's Electronic Creations
+  * @brief   PixelColorTable
+  *          Read-only view over an array of colors kept in program memory, for
+  *          palettes and preset banks. On AVR the array lives in flash (PROGMEM) and
+  *          elements are copied out on read; elsewhere it is ordinary read-only data.
+  *          Either way the table costs no RAM and no startup work.
+  *
+  *          Usage:
+  *            const PixelColor presetColors[] PixelColorTable_PROGMEM =
+  *            {
+  *                PixelColor(0, 0, 255),
+  *                PixelColor(255, 0, 0),
+  *            };
+  *            constexpr PixelColorTable presets(presetColors, 2);
+  *
+  *            PixelColor color = presets.At(1);
+  *************************************************************************************
+**/
+
+#ifndef __PixelColorTable_H_
+#define __PixelColorTable_H_
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+#ifdef __AVR__
+#define PixelColorTable_PROGMEM PROGMEM
+#else
+#define PixelColorTable_PROGMEM
+#endif
+
+static_assert(sizeof(PixelColor) == 4, "PixelColorTable reads PixelColor as 4 raw bytes.");
+
+class PixelColorTable
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the PixelColorTable class.
+     *
+     * @param   colors
+     *          Array declared with PixelColorTable_PROGMEM.
+     *
+     * @param   count
+     *          Number of colors in the array.
+     **/
+    constexpr PixelColorTable(const PixelColor *colors, uint16_t count)
+        : _colors(colors)
+        , _count(count)
+    {
+    }
+
+    /**
+     * @brief   Number of colors in the table.
+     **/
+    constexpr uint16_t Count() const { return _count; }
+
+    /**
+     * @brief   Read one color.
+     *
+     * @return  The color at index, or black if index is out of range.
+     **/
+    PixelColor At(uint16_t index) const;
+
+    /**
+     * @brief   Copy a range of colors into RAM in one pass, ie to load a palette for
+     *          an IndexedPixelBuffer.
+     *
+     * @param   out
+     *          Receives up to count colors.
+     *
+     * @param   start
+     *          First color to copy.
+     *
+     * @param   count
+     *          Number of colors to copy.
+     *
+     * @return  Number of colors copied.
+     **/
+    uint16_t CopyTo(PixelColor *out, uint16_t start, uint16_t count) const;
+
+  private:
+    const PixelColor *_colors;
+    uint16_t _count;
+};
+
+#endif //__PixelColorTable_H_
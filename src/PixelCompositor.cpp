@@ -0,0 +1,294 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "PixelCompositor.h"
+
+namespace PixelCompositorHelpers
+{
+    // Pixels blended per tile. Every layer is applied to a tile before it is written
+    // out, which is what lets the output alias a layer buffer.
+    const uint8_t TileSize = 16;
+
+    // a * b / 255, exact at both ends.
+    inline uint8_t Multiply(uint8_t a, uint8_t b)
+    {
+        return (uint8_t)(((uint16_t)a * b + 255) >> 8);
+    }
+
+    // Mix from a to b where weight is in [0, 256].
+    inline uint8_t Lerp(uint8_t a, uint8_t b, uint16_t weight)
+    {
+        return (uint8_t)(((uint16_t)a * (256 - weight) + (uint16_t)b * weight) >> 8);
+    }
+
+    // Opacity as a Lerp weight, so 255 maps to exactly 256.
+    inline uint16_t Weight(uint8_t opacity)
+    {
+        return opacity + (opacity >> 7);
+    }
+
+    // One channel of src blended over dst. Mode is a template argument so each
+    // instantiation of BlendPixels compiles to a loop with no branch on the mode.
+    template <uint8_t Mode>
+    inline uint8_t BlendChannel(uint8_t dst, uint8_t src, uint8_t opacity, uint16_t weight)
+    {
+        switch (Mode)
+        {
+            case BlendMode::BlendBase:
+                return Multiply(src, opacity);
+            case BlendMode::BlendAdd:
+            {
+                uint16_t sum = (uint16_t)dst + Multiply(src, opacity);
+                return sum > 255 ? 255 : (uint8_t)sum;
+            }
+            case BlendMode::BlendMultiply:
+                return Lerp(dst, Multiply(dst, src), weight);
+            case BlendMode::BlendScreen:
+                return Lerp(dst, 255 - Multiply(255 - dst, 255 - src), weight);
+            case BlendMode::BlendAlphaOver:
+            default:
+                return Lerp(dst, src, weight);
+        }
+    }
+
+    // Blend count pixels of a buffer layer over dst, four channels per pixel.
+    template <uint8_t Mode>
+    void BlendPixels(uint8_t *dst, const PixelColor *src, uint8_t count, uint8_t opacity)
+    {
+        uint16_t weight = Weight(opacity);
+        for (uint8_t p = 0; p < count; p++, dst += 4)
+        {
+            dst[0] = BlendChannel<Mode>(dst[0], src[p].Red(), opacity, weight);
+            dst[1] = BlendChannel<Mode>(dst[1], src[p].Green(), opacity, weight);
+            dst[2] = BlendChannel<Mode>(dst[2], src[p].Blue(), opacity, weight);
+            dst[3] = BlendChannel<Mode>(dst[3], src[p].White(), opacity, weight);
+        }
+    }
+
+    // Blend count pixels of a solid layer, in any mode but add, over dst.
+    void BlendSolid(uint8_t *dst, const uint16_t *scale, const uint16_t *offset, uint8_t count)
+    {
+        for (uint8_t p = 0; p < count; p++, dst += 4)
+        {
+            for (uint8_t c = 0; c < 4; c++)
+            {
+                dst[c] = (uint8_t)(((uint16_t)dst[c] * scale[c] + offset[c]) >> 8);
+            }
+        }
+    }
+
+    // Add count pixels of a premultiplied solid color to dst, saturating.
+    void AddSolid(uint8_t *dst, const uint16_t *color, uint8_t count)
+    {
+        for (uint8_t p = 0; p < count; p++, dst += 4)
+        {
+            for (uint8_t c = 0; c < 4; c++)
+            {
+                uint16_t sum = dst[c] + color[c];
+                dst[c] = sum > 255 ? 255 : (uint8_t)sum;
+            }
+        }
+    }
+}
+
+using namespace PixelCompositorHelpers;
+
+PixelCompositor::PixelCompositor(PixelCompositorLayer *layers, uint8_t capacity)
+    : _layers(layers)
+    , _capacity(capacity > 127 ? 127 : capacity)
+    , _layerCount(0)
+{
+}
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+int8_t PixelCompositor::AddLayer(BlendMode mode, const PixelColor *pixels)
+{
+    if (pixels == nullptr) { return PixelCompositor_UnableToAdd; }
+    return Add(mode, pixels, PixelColor());
+}
+
+int8_t PixelCompositor::AddSolidLayer(BlendMode mode, const PixelColor &color)
+{
+    return Add(mode, nullptr, color);
+}
+
+void PixelCompositor::Clear()
+{
+    this->_layerCount = 0;
+}
+
+void PixelCompositor::SetOpacity(int8_t layer, uint8_t opacity)
+{
+    if (!IsValid(layer)) { return; }
+    this->_layers[layer].opacity = opacity;
+    UpdateSolidTerms(this->_layers[layer]);
+}
+
+void PixelCompositor::SetRange(int8_t layer, uint16_t start, uint16_t end)
+{
+    if (!IsValid(layer)) { return; }
+    this->_layers[layer].start = start;
+    this->_layers[layer].end = end;
+}
+
+void PixelCompositor::SetEnabled(int8_t layer, bool isEnabled)
+{
+    if (!IsValid(layer)) { return; }
+    this->_layers[layer].isEnabled = isEnabled;
+}
+
+void PixelCompositor::SetColor(int8_t layer, const PixelColor &color)
+{
+    if (!IsValid(layer) || this->_layers[layer].pixels != nullptr) { return; }
+    this->_layers[layer].color = color;
+    UpdateSolidTerms(this->_layers[layer]);
+}
+
+void PixelCompositor::SetPixels(int8_t layer, const PixelColor *pixels)
+{
+    if (!IsValid(layer) || this->_layers[layer].pixels == nullptr || pixels == nullptr) { return; }
+    this->_layers[layer].pixels = pixels;
+}
+
+void PixelCompositor::Render(PixelColor *out, uint16_t count) const
+{
+    // A fully opaque base layer over the whole output hides everything below it.
+    uint8_t first = 0;
+    for (uint8_t i = 0; i < this->_layerCount; i++)
+    {
+        const PixelCompositorLayer &layer = this->_layers[i];
+        if (layer.isEnabled && layer.mode == BlendMode::BlendBase && layer.opacity == 255
+            && layer.start == 0 && layer.end >= count)
+        {
+            first = i;
+        }
+    }
+
+    uint8_t tile[TileSize * 4];
+
+    for (uint16_t tileStart = 0; tileStart < count; tileStart += TileSize)
+    {
+        uint16_t tileEnd = count - tileStart > TileSize ? tileStart + TileSize : count;
+        memset(tile, 0, sizeof(tile));
+
+        for (uint8_t i = first; i < this->_layerCount; i++)
+        {
+            const PixelCompositorLayer &layer = this->_layers[i];
+            uint16_t start = layer.start > tileStart ? layer.start : tileStart;
+            uint16_t end = layer.end < tileEnd ? layer.end : tileEnd;
+            if (!layer.isEnabled || layer.opacity == 0 || start >= end) { continue; }
+
+            uint8_t *dst = tile + (start - tileStart) * 4;
+            uint8_t span = (uint8_t)(end - start);
+
+            if (layer.pixels == nullptr)
+            {
+                if (layer.mode == BlendMode::BlendAdd) { AddSolid(dst, layer.offset, span); }
+                else { BlendSolid(dst, layer.scale, layer.offset, span); }
+                continue;
+            }
+
+            const PixelColor *src = layer.pixels + start;
+            switch (layer.mode)
+            {
+                case BlendMode::BlendBase:
+                    BlendPixels<BlendMode::BlendBase>(dst, src, span, layer.opacity);
+                    break;
+                case BlendMode::BlendAdd:
+                    BlendPixels<BlendMode::BlendAdd>(dst, src, span, layer.opacity);
+                    break;
+                case BlendMode::BlendMultiply:
+                    BlendPixels<BlendMode::BlendMultiply>(dst, src, span, layer.opacity);
+                    break;
+                case BlendMode::BlendScreen:
+                    BlendPixels<BlendMode::BlendScreen>(dst, src, span, layer.opacity);
+                    break;
+                default:
+                    BlendPixels<BlendMode::BlendAlphaOver>(dst, src, span, layer.opacity);
+                    break;
+            }
+        }
+
+        const uint8_t *pixel = tile;
+        for (uint16_t p = tileStart; p < tileEnd; p++, pixel += 4)
+        {
+            out[p] = PixelColor(pixel[0], pixel[1], pixel[2], pixel[3]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+int8_t PixelCompositor::Add(BlendMode mode, const PixelColor *pixels, const PixelColor &color)
+{
+    if (this->_layerCount >= this->_capacity || mode >= BLEND_MODE_Count)
+    {
+        return PixelCompositor_UnableToAdd;
+    }
+
+    PixelCompositorLayer &layer = this->_layers[this->_layerCount];
+    layer.pixels = pixels;
+    layer.color = color;
+    layer.start = 0;
+    layer.end = PixelCompositor_RangeEnd;
+    layer.mode = mode;
+    layer.opacity = 255;
+    layer.isEnabled = true;
+    UpdateSolidTerms(layer);
+
+    return (int8_t)this->_layerCount++;
+}
+
+bool PixelCompositor::IsValid(int8_t layer) const
+{
+    return layer >= 0 && layer < this->_layerCount;
+}
+
+void PixelCompositor::UpdateSolidTerms(PixelCompositorLayer &layer)
+{
+    if (layer.pixels != nullptr) { return; }
+
+    uint16_t weight = Weight(layer.opacity);
+    const uint8_t color[4] = { layer.color.Red(), layer.color.Green(), layer.color.Blue(), layer.color.White() };
+
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        switch (layer.mode)
+        {
+            case BlendMode::BlendBase:
+                layer.scale[c] = 0;
+                layer.offset[c] = (uint16_t)Multiply(color[c], layer.opacity) << 8;
+                break;
+            case BlendMode::BlendAdd:
+                layer.scale[c] = 256;
+                layer.offset[c] = Multiply(color[c], layer.opacity);
+                break;
+            case BlendMode::BlendMultiply:
+                // Lerp(dst, dst * color / 255, weight) is dst times a constant.
+                layer.scale[c] = 256 - weight + ((uint16_t)weight * color[c] + 127) / 255;
+                layer.offset[c] = 0;
+                break;
+            case BlendMode::BlendScreen:
+                // The same, scaling 255 - dst, then flipped back.
+                layer.scale[c] = 256 - weight + ((uint16_t)weight * (255 - color[c]) + 127) / 255;
+                layer.offset[c] = 255 * (256 - layer.scale[c]);
+                break;
+            case BlendMode::BlendAlphaOver:
+            default:
+                layer.scale[c] = 256 - weight;
+                layer.offset[c] = (uint16_t)color[c] * weight;
+                break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------
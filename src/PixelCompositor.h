@@ -0,0 +1,193 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    PixelCompositor.h
+  * @author  Naigon's Electronic Creations
+  * @brief   PixelCompositor
+  *          Renders a stack of color layers into one pixel buffer in a single pass.
+  *          Each layer is either a pixel buffer or a solid color, and has a blend
+  *          mode, an opacity and a range of output pixels it applies to. Layers are
+  *          applied bottom (first added) to top.
+  *
+  *          The output is blended a tile of pixels at a time. Each layer is clipped to
+  *          its range once per tile and blended by a loop specialized for its mode, so
+  *          nothing is tested per pixel; layers that are disabled, fully transparent or
+  *          outside the tile cost nothing. Solid layers are reduced to a scale and
+  *          offset per channel whenever they change, which makes most of them a single
+  *          multiply-add per channel.
+  *
+  *          All blending is 8-bit integer math; no floats are used per pixel. Layer
+  *          storage is supplied by the caller, most simply by declaring a
+  *          StaticPixelCompositor with room for the layers the effect stacks.
+  *************************************************************************************
+**/
+
+#ifndef __PixelCompositor_H_
+#define __PixelCompositor_H_
+
+#include "Arduino.h"
+#include "PixelColor.h"
+
+#define PixelCompositor_UnableToAdd -1
+
+// Range end value meaning "to the end of the output".
+#define PixelCompositor_RangeEnd 0xFFFF
+
+enum BlendMode : uint8_t
+{
+    // Replaces everything below; opacity scales the layer color toward black.
+    BlendBase = 0,
+
+    // Adds the layer to what is below, saturating at full brightness.
+    BlendAdd = 1,
+
+    // Multiplies with what is below; darkens. Useful for masks and fades.
+    BlendMultiply = 2,
+
+    // Inverse multiply; brightens without saturating as hard as add.
+    BlendScreen = 3,
+
+    // Standard alpha blend, using opacity as the alpha.
+    BlendAlphaOver = 4,
+
+    BLEND_MODE_Count = 5,
+};
+
+// Storage for one layer. Used only by PixelCompositor; do not modify.
+struct PixelCompositorLayer
+{
+    const PixelColor *pixels;
+    PixelColor color;
+    uint16_t start;
+    uint16_t end;
+    uint8_t mode;
+    uint8_t opacity;
+    bool isEnabled;
+
+    // Solid layers only: each channel blends as (dst * scale + offset) >> 8. For
+    // BlendAdd, offset is instead the color premultiplied by opacity.
+    uint16_t scale[4];
+    uint16_t offset[4];
+};
+
+class PixelCompositor
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the PixelCompositor class.
+     *
+     * @param   layers
+     *          Storage for capacity layers. Must outlive the compositor.
+     *
+     * @param   capacity
+     *          Most layers that can be added; at most 127, the largest handle.
+     **/
+    PixelCompositor(PixelCompositorLayer *layers, uint8_t capacity);
+
+    /**
+     * @brief   Add a layer backed by a pixel buffer. The buffer is indexed by output
+     *          position, so it must hold at least as many pixels as the end of the
+     *          layer range (or the output size if the range is open).
+     *
+     * @param   mode
+     *          How the layer is combined with the layers below.
+     *
+     * @param   pixels
+     *          Layer pixels. Not copied; must stay valid while the layer exists.
+     *
+     * @return  Layer handle if successful; otherwise PixelCompositor_UnableToAdd.
+     **/
+    int8_t AddLayer(BlendMode mode, const PixelColor *pixels);
+
+    /**
+     * @brief   Add a layer with a single color for every pixel.
+     *
+     * @return  Layer handle if successful; otherwise PixelCompositor_UnableToAdd.
+     **/
+    int8_t AddSolidLayer(BlendMode mode, const PixelColor &color);
+
+    /**
+     * @brief   Remove all layers.
+     **/
+    void Clear();
+
+    /**
+     * @brief   Set the opacity of a layer. Zero (0) skips the layer entirely; 255 is
+     *          fully opaque. Layers start fully opaque.
+     **/
+    void SetOpacity(int8_t layer, uint8_t opacity);
+
+    /**
+     * @brief   Restrict a layer to output pixels [start, end). Layers start covering
+     *          the whole output.
+     *
+     * @param   end
+     *          One past the last pixel, or PixelCompositor_RangeEnd for the end of the
+     *          output.
+     **/
+    void SetRange(int8_t layer, uint16_t start, uint16_t end);
+
+    /**
+     * @brief   Enable or disable a layer without removing it.
+     **/
+    void SetEnabled(int8_t layer, bool isEnabled);
+
+    /**
+     * @brief   Change the color of a solid layer.
+     **/
+    void SetColor(int8_t layer, const PixelColor &color);
+
+    /**
+     * @brief   Change the buffer of a buffer layer.
+     **/
+    void SetPixels(int8_t layer, const PixelColor *pixels);
+
+    /**
+     * @brief   Composite all active layers into the output buffer. Pixels not covered
+     *          by any layer are set to black.
+     *
+     * @param   out
+     *          Output buffer. May be the same buffer as a layer source, since each
+     *          pixel is read from every layer before it is written.
+     *
+     * @param   count
+     *          Number of pixels to render.
+     **/
+    void Render(PixelColor *out, uint16_t count) const;
+
+  private:
+    int8_t Add(BlendMode mode, const PixelColor *pixels, const PixelColor &color);
+    bool IsValid(int8_t layer) const;
+    void UpdateSolidTerms(PixelCompositorLayer &layer);
+
+    PixelCompositorLayer *_layers;
+    uint8_t _capacity;
+    uint8_t _layerCount;
+};
+
+/**
+ * @brief   PixelCompositor with its own storage for Layers layers.
+ **/
+template <uint8_t Layers>
+class StaticPixelCompositor : public PixelCompositor
+{
+    static_assert(Layers > 0 && Layers <= 127, "Layer handles are int8_t");
+
+  public:
+    StaticPixelCompositor()
+        : PixelCompositor(_layerStorage, Layers)
+    {
+    }
+
+    // The base points at _layerStorage, so a copy would render the original's layers.
+    StaticPixelCompositor(const StaticPixelCompositor&) = delete;
+    StaticPixelCompositor& operator=(const StaticPixelCompositor&) = delete;
+
+  private:
+    PixelCompositorLayer _layerStorage[Layers];
+};
+
+#endif //__PixelCompositor_H_
@@ -0,0 +1,341 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "TaskRunner.h"
+
+#define TaskRunner_EndOfList 0xFFFF
+
+namespace TaskRunnerHelpers
+{
+    enum TaskState : uint8_t
+    {
+        TaskStateFree,
+        // In the ready list, or taken from it by the current Run.
+        TaskStateReady,
+        TaskStateSleeping,
+        TaskStateWaiting,
+        // Cancelled while ready; released when Run reaches it.
+        TaskStateCancelled,
+    };
+
+    // Wrap-safe, so waits keep working when the clock rolls over after 49 days.
+    inline bool IsDue(uint32_t wakeTime, uint32_t now)
+    {
+        return (int32_t)(wakeTime - now) <= 0;
+    }
+}
+
+using namespace TaskRunnerHelpers;
+
+TaskRunner::TaskRunner(Task *tasks, uint16_t *timerHeap, uint16_t capacity)
+    : _tasks(tasks)
+    , _heap(timerHeap)
+    , _capacity(capacity == TaskRunner_EndOfList ? capacity - 1 : capacity)
+    , _heapCount(0)
+    , _activeCount(0)
+    , _freeHead(TaskRunner_EndOfList)
+    , _readyHead(TaskRunner_EndOfList)
+    , _readyTail(TaskRunner_EndOfList)
+    , _waitingHead(TaskRunner_EndOfList)
+    , _waitingTail(TaskRunner_EndOfList)
+{
+    // Chain the free list so the lowest slots are used first.
+    for (uint16_t i = this->_capacity; i > 0; i--)
+    {
+        this->_tasks[i - 1].state = TaskStateFree;
+        this->_tasks[i - 1].next = this->_freeHead;
+        this->_freeHead = i - 1;
+    }
+
+    this->_clock.Start();
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+bool TaskRunner::IsRunning(int16_t handle) const
+{
+    if (handle < 0 || (uint16_t)handle >= this->_capacity) { return false; }
+
+    uint8_t state = this->_tasks[handle].state;
+    return state != TaskStateFree && state != TaskStateCancelled;
+}
+
+uint32_t TaskRunner::Now() const
+{
+    return this->_clock.ElapsedTime();
+}
+
+uint16_t TaskRunner::ActiveCount() const
+{
+    return this->_activeCount;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+int16_t TaskRunner::Start(TaskFunction function, void *arg)
+{
+    if (function == nullptr || this->_freeHead == TaskRunner_EndOfList)
+    {
+        return TaskRunner_UnableToStart;
+    }
+
+    uint16_t index = this->_freeHead;
+    Task &task = this->_tasks[index];
+    this->_freeHead = task.next;
+
+    task.function = function;
+    task.arg = arg;
+    task.counter = 0;
+    task.resumePoint = 0;
+    task.wakeTime = 0;
+    task.waitEvent = 0;
+    task.state = TaskStateReady;
+    Append(this->_readyHead, this->_readyTail, index);
+    this->_activeCount++;
+
+    return (int16_t)index;
+}
+
+void TaskRunner::Cancel(int16_t handle)
+{
+    if (!IsRunning(handle)) { return; }
+
+    uint16_t index = (uint16_t)handle;
+    Task &task = this->_tasks[index];
+
+    switch (task.state)
+    {
+        case TaskStateReady:
+            // It may be in a list Run is walking, so leave the unlinking to Run.
+            task.state = TaskStateCancelled;
+            break;
+
+        case TaskStateSleeping:
+            for (uint16_t position = 0; position < this->_heapCount; position++)
+            {
+                if (this->_heap[position] != index) { continue; }
+
+                HeapRemove(position);
+                break;
+            }
+            Release(index);
+            break;
+
+        case TaskStateWaiting:
+            Unlink(this->_waitingHead, this->_waitingTail, index);
+            Release(index);
+            break;
+    }
+}
+
+uint16_t TaskRunner::Signal(uint8_t eventId)
+{
+    uint16_t woken = 0;
+    uint16_t previous = TaskRunner_EndOfList;
+    uint16_t index = this->_waitingHead;
+
+    while (index != TaskRunner_EndOfList)
+    {
+        Task &task = this->_tasks[index];
+        uint16_t next = task.next;
+
+        if (task.waitEvent != eventId)
+        {
+            previous = index;
+            index = next;
+            continue;
+        }
+
+        if (previous == TaskRunner_EndOfList) { this->_waitingHead = next; }
+        else { this->_tasks[previous].next = next; }
+        if (this->_waitingTail == index) { this->_waitingTail = previous; }
+
+        task.state = TaskStateReady;
+        Append(this->_readyHead, this->_readyTail, index);
+        woken++;
+        index = next;
+    }
+
+    return woken;
+}
+
+uint16_t TaskRunner::Run()
+{
+    this->_clock.Update();
+    uint32_t now = Now();
+
+    // Take everything that is ready now; tasks that yield, start or are signaled
+    // while these run go on the fresh ready list for the next call.
+    uint16_t head = this->_readyHead;
+    uint16_t tail = this->_readyTail;
+    this->_readyHead = TaskRunner_EndOfList;
+    this->_readyTail = TaskRunner_EndOfList;
+
+    // Only the earliest sleepers are looked at; the rest of the heap is not touched.
+    while (this->_heapCount > 0 && IsDue(this->_tasks[this->_heap[0]].wakeTime, now))
+    {
+        uint16_t index = HeapPop();
+        this->_tasks[index].state = TaskStateReady;
+        Append(head, tail, index);
+    }
+
+    uint16_t resumed = 0;
+    while (head != TaskRunner_EndOfList)
+    {
+        uint16_t index = head;
+        Task &task = this->_tasks[index];
+        head = task.next;
+
+        if (task.state == TaskStateCancelled)
+        {
+            Release(index);
+            continue;
+        }
+
+        int8_t status = task.function(task);
+        resumed++;
+
+        // The task may have cancelled itself.
+        if (task.state == TaskStateCancelled)
+        {
+            Release(index);
+            continue;
+        }
+
+        switch (status)
+        {
+            case TaskYield:
+                Append(this->_readyHead, this->_readyTail, index);
+                break;
+
+            case TaskSleep:
+                task.wakeTime += now;
+                task.state = TaskStateSleeping;
+                HeapPush(index);
+                break;
+
+            case TaskWaitEvent:
+                task.state = TaskStateWaiting;
+                Append(this->_waitingHead, this->_waitingTail, index);
+                break;
+
+            default:
+                Release(index);
+                break;
+        }
+    }
+
+    return resumed;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+void TaskRunner::Append(uint16_t &head, uint16_t &tail, uint16_t index)
+{
+    this->_tasks[index].next = TaskRunner_EndOfList;
+
+    if (tail == TaskRunner_EndOfList) { head = index; }
+    else { this->_tasks[tail].next = index; }
+    tail = index;
+}
+
+void TaskRunner::Unlink(uint16_t &head, uint16_t &tail, uint16_t index)
+{
+    uint16_t previous = TaskRunner_EndOfList;
+    for (uint16_t i = head; i != TaskRunner_EndOfList; previous = i, i = this->_tasks[i].next)
+    {
+        if (i != index) { continue; }
+
+        uint16_t next = this->_tasks[i].next;
+        if (previous == TaskRunner_EndOfList) { head = next; }
+        else { this->_tasks[previous].next = next; }
+        if (tail == index) { tail = previous; }
+        return;
+    }
+}
+
+void TaskRunner::Release(uint16_t index)
+{
+    Task &task = this->_tasks[index];
+    task.state = TaskStateFree;
+    task.next = this->_freeHead;
+    this->_freeHead = index;
+    this->_activeCount--;
+}
+
+bool TaskRunner::WakesBefore(uint16_t a, uint16_t b) const
+{
+    return (int32_t)(this->_tasks[a].wakeTime - this->_tasks[b].wakeTime) < 0;
+}
+
+void TaskRunner::HeapPush(uint16_t index)
+{
+    this->_heap[this->_heapCount] = index;
+    SiftUp(this->_heapCount++);
+}
+
+uint16_t TaskRunner::HeapPop()
+{
+    uint16_t top = this->_heap[0];
+    HeapRemove(0);
+    return top;
+}
+
+void TaskRunner::HeapRemove(uint16_t position)
+{
+    this->_heapCount--;
+    if (position == this->_heapCount) { return; }
+
+    // Move the last entry into the hole; it may need to go either way from there.
+    this->_heap[position] = this->_heap[this->_heapCount];
+    SiftUp(position);
+    SiftDown(position);
+}
+
+void TaskRunner::SiftUp(uint16_t position)
+{
+    uint16_t index = this->_heap[position];
+    while (position > 0)
+    {
+        uint16_t parent = (position - 1) >> 1;
+        if (!WakesBefore(index, this->_heap[parent])) { break; }
+
+        this->_heap[position] = this->_heap[parent];
+        position = parent;
+    }
+    this->_heap[position] = index;
+}
+
+void TaskRunner::SiftDown(uint16_t position)
+{
+    uint16_t index = this->_heap[position];
+    for (;;)
+    {
+        uint32_t child = 2 * (uint32_t)position + 1;
+        if (child >= this->_heapCount) { break; }
+        if (child + 1 < this->_heapCount && WakesBefore(this->_heap[child + 1], this->_heap[child]))
+        {
+            child++;
+        }
+        if (!WakesBefore(this->_heap[child], index)) { break; }
+
+        this->_heap[position] = this->_heap[child];
+        position = (uint16_t)child;
+    }
+    this->_heap[position] = index;
+}
+
+// ------------------------------------------------------------------------------------
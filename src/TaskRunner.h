@@ -0,0 +1,217 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    TaskRunner.h
+  * @author  Naigon's Electronic Creations
+  * @brief   TaskRunner
+  *          Cooperative runner for stackless tasks: multi-step sequences such as
+  *          ignition, retraction or boot animations, written top to bottom instead of
+  *          as a hand-rolled state machine, and without blocking on delay().
+  *
+  *          A task is a function that is re-entered where it last waited:
+  *
+  *            int8_t Ignite(Task &task)
+  *            {
+  *                TaskRunner_Begin(task);
+  *                for (task.counter = 0; task.counter < 10; task.counter++)
+  *                {
+  *                    ExtendBlade(task.counter);
+  *                    TaskRunner_WaitMS(task, 30);
+  *                }
+  *                TaskRunner_WaitEvent(task, EventIgnitionDone);
+  *                PlayHum();
+  *                TaskRunner_End(task);
+  *            }
+  *
+  *          Local variables do not survive a wait; keep state in task.counter or in
+  *          the object task.arg points to. Do not use switch statements across waits,
+  *          and use at most one wait per source line.
+  *
+  *          Each task is 16 bytes on AVR. Sleeping tasks are kept in a min-heap by
+  *          wake time (timed with a Stopwatch), so Run only touches the tasks that are
+  *          due rather than polling every one.
+  *************************************************************************************
+**/
+
+#ifndef __TaskRunner_H_
+#define __TaskRunner_H_
+
+#include "Arduino.h"
+#include "Stopwatch.h"
+
+#define TaskRunner_UnableToStart -1
+
+// What a task asked for when it returned. Returned by the TaskRunner_ macros; task
+// functions should not need to use these directly.
+enum TaskStatus : int8_t
+{
+    TaskDone = 0,
+    // Run again on the next call to Run, ie the next frame.
+    TaskYield = 1,
+    TaskSleep = 2,
+    TaskWaitEvent = 3,
+};
+
+struct Task;
+typedef int8_t (*TaskFunction)(Task &task);
+
+struct Task
+{
+    TaskFunction function;
+
+    // Argument given to TaskRunner::Start, ie the effect the sequence drives.
+    void *arg;
+
+    // Scratch value kept across waits, ie a loop counter.
+    uint16_t counter;
+
+    // Used by the TaskRunner_ macros and TaskRunner; do not modify.
+    uint16_t resumePoint;
+    uint32_t wakeTime;
+    uint16_t next;
+    uint8_t state;
+    uint8_t waitEvent;
+};
+
+// Marks the start of a task body. Must be the first statement of the task function.
+#define TaskRunner_Begin(task) \
+    switch ((task).resumePoint) { case 0:
+
+// Ends the task. Must be the last statement of the task function.
+#define TaskRunner_End(task) \
+    } (task).resumePoint = 0; return TaskDone
+
+// Suspends the task until the next call to Run.
+#define TaskRunner_Yield(task) \
+    do { (task).resumePoint = __LINE__; return TaskYield; case __LINE__:; } while (0)
+
+// Suspends the task for at least ms milliseconds from the current frame.
+#define TaskRunner_WaitMS(task, ms) \
+    do { (task).resumePoint = __LINE__; (task).wakeTime = (ms); return TaskSleep; case __LINE__:; } while (0)
+
+// Suspends the task until TaskRunner::Signal is called with eventId.
+#define TaskRunner_WaitEvent(task, eventId) \
+    do { (task).resumePoint = __LINE__; (task).waitEvent = (eventId); return TaskWaitEvent; case __LINE__:; } while (0)
+
+// Yields every frame until condition is true.
+#define TaskRunner_WaitUntil(task, condition) \
+    while (!(condition)) { TaskRunner_Yield(task); }
+
+class TaskRunner
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the TaskRunner class and starts its clock.
+     *
+     * @param   tasks
+     *          Storage for capacity tasks. Must outlive the runner.
+     *
+     * @param   timerHeap
+     *          Storage for capacity indices, used to order sleeping tasks.
+     *
+     * @param   capacity
+     *          Most tasks that can run at once; less than 0xFFFF.
+     **/
+    TaskRunner(Task *tasks, uint16_t *timerHeap, uint16_t capacity);
+
+    /**
+     * @brief   Starts a task. It first runs on the next call to Run.
+     *
+     * @param   function
+     *          The task body.
+     *
+     * @param   arg
+     *          Stored in task.arg.
+     *
+     * @return  Handle for Cancel and IsRunning; or TaskRunner_UnableToStart if every
+     *          task slot is in use.
+     **/
+    int16_t Start(TaskFunction function, void *arg = nullptr);
+
+    /**
+     * @brief   Stops a task wherever it is waiting. It will not run again.
+     **/
+    void Cancel(int16_t handle);
+
+    /**
+     * @brief   Whether the task of a handle has not yet finished or been cancelled.
+     *          Handles are reused, so only meaningful until the task ends.
+     **/
+    bool IsRunning(int16_t handle) const;
+
+    /**
+     * @brief   Wakes every task waiting on the event. They resume on the next Run.
+     *
+     * @return  Number of tasks woken.
+     **/
+    uint16_t Signal(uint8_t eventId);
+
+    /**
+     * @brief   Resumes every task that is due: those that yielded, were started or
+     *          signaled since the last call, and those whose wait has elapsed. Call
+     *          once per loop iteration.
+     *
+     * @return  Number of tasks resumed.
+     **/
+    uint16_t Run();
+
+    /**
+     * @brief   Milliseconds on the runner's clock as of the last Run.
+     **/
+    uint32_t Now() const;
+
+    /**
+     * @brief   Number of tasks started and not yet finished.
+     **/
+    uint16_t ActiveCount() const;
+
+  private:
+    void Append(uint16_t &head, uint16_t &tail, uint16_t index);
+    void Unlink(uint16_t &head, uint16_t &tail, uint16_t index);
+    void Release(uint16_t index);
+    void HeapPush(uint16_t index);
+    uint16_t HeapPop();
+    void HeapRemove(uint16_t position);
+    void SiftUp(uint16_t position);
+    void SiftDown(uint16_t position);
+    bool WakesBefore(uint16_t a, uint16_t b) const;
+
+    Task *_tasks;
+    uint16_t *_heap;
+    Stopwatch _clock;
+    uint16_t _capacity;
+    uint16_t _heapCount;
+    uint16_t _activeCount;
+    uint16_t _freeHead;
+    uint16_t _readyHead;
+    uint16_t _readyTail;
+    uint16_t _waitingHead;
+    uint16_t _waitingTail;
+};
+
+/**
+ * @brief   TaskRunner with its own storage for Capacity tasks.
+ **/
+template <uint16_t Capacity>
+class StaticTaskRunner : public TaskRunner
+{
+  public:
+    StaticTaskRunner()
+        : TaskRunner(_taskStorage, _heapStorage, Capacity)
+    {
+    }
+
+    // The base points at this object's storage, so a copy would run the original's
+    // tasks.
+    StaticTaskRunner(const StaticTaskRunner&) = delete;
+    StaticTaskRunner& operator=(const StaticTaskRunner&) = delete;
+
+  private:
+    Task _taskStorage[Capacity];
+    uint16_t _heapStorage[Capacity];
+};
+
+#endif //__TaskRunner_H_
@@ -0,0 +1,190 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+#include "TraceRecorder.h"
+
+TraceRecorder::TraceRecorder(TraceRecord *buffer, uint16_t capacity)
+    : _buffer(buffer)
+    , _capacity(capacity)
+    , _head(0)
+    , _count(0)
+    , _dropped(0)
+    , _lastMillis(0)
+    , _buttonLevels(0)
+    , _isRecording(false)
+{
+}
+
+// ------------------------------------------------------------------------------------
+// Properties
+// ------------------------------------------------------------------------------------
+
+uint16_t TraceRecorder::Count() const
+{
+    return this->_count;
+}
+
+uint32_t TraceRecorder::DroppedCount() const
+{
+    return this->_dropped;
+}
+
+const TraceRecord& TraceRecorder::At(uint16_t index) const
+{
+    // Oldest record sits right after the head once the buffer has wrapped.
+    uint16_t start = this->_count < this->_capacity ? 0 : this->_head;
+    uint16_t position = start + index;
+    if (position >= this->_capacity) { position -= this->_capacity; }
+
+    return this->_buffer[position];
+}
+
+uint32_t TraceRecorder::SerializedSize() const
+{
+    return TraceRecorder_HeaderSize + (uint32_t)this->_count * TraceRecorder_RecordSize;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Public Methods
+// ------------------------------------------------------------------------------------
+
+void TraceRecorder::Start()
+{
+    this->_lastMillis = millis();
+    this->_isRecording = true;
+}
+
+void TraceRecorder::Stop()
+{
+    this->_isRecording = false;
+}
+
+void TraceRecorder::Clear()
+{
+    this->_head = 0;
+    this->_count = 0;
+    this->_dropped = 0;
+    this->_buttonLevels = 0;
+    this->_lastMillis = millis();
+}
+
+ButtonState TraceRecorder::SampleButton(Button &button)
+{
+    ButtonState state = button.DetermineButtonState();
+    if (!this->_isRecording) { return state; }
+
+    uint8_t id = button.Id();
+    bool isPressed = button.WasPressed();
+    bool levelChanged = false;
+
+    if (id < TraceRecorder_TrackedButtons)
+    {
+        uint32_t mask = (uint32_t)1 << id;
+        levelChanged = ((this->_buttonLevels & mask) != 0) != isPressed;
+        this->_buttonLevels = isPressed
+            ? this->_buttonLevels | mask
+            : this->_buttonLevels & ~mask;
+    }
+
+    if (levelChanged || state != ButtonState::NotPressed)
+    {
+        RecordButton(id, isPressed, state);
+    }
+
+    return state;
+}
+
+void TraceRecorder::RecordButton(uint8_t buttonId, bool isPressed, ButtonState state)
+{
+    uint16_t value = (uint16_t)state | (isPressed ? TraceRecorder_ButtonPressedFlag : 0);
+    Append(TraceKind::TraceButton, buttonId, value);
+}
+
+void TraceRecorder::RecordCallback(uint8_t sourceId, uint16_t value)
+{
+    Append(TraceKind::TraceCallback, sourceId, value);
+}
+
+void TraceRecorder::RecordProbe(uint8_t probeId, const Stopwatch &stopwatch)
+{
+    uint32_t elapsed = stopwatch.ElapsedTimeMicros();
+    Append(TraceKind::TraceProbe, probeId, elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed);
+}
+
+uint32_t TraceRecorder::Serialize(uint8_t *out, uint32_t size) const
+{
+    uint32_t required = SerializedSize();
+    if (size < required) { return 0; }
+
+    out[0] = 'C';
+    out[1] = 'G';
+    out[2] = 'T';
+    out[3] = TraceRecorder_Version;
+    out[4] = (uint8_t)this->_count;
+    out[5] = (uint8_t)(this->_count >> 8);
+    out += TraceRecorder_HeaderSize;
+
+    for (uint16_t i = 0; i < this->_count; i++)
+    {
+        const TraceRecord &record = At(i);
+        out[0] = (uint8_t)record.deltaMS;
+        out[1] = (uint8_t)(record.deltaMS >> 8);
+        out[2] = record.kind;
+        out[3] = record.id;
+        out[4] = (uint8_t)record.value;
+        out[5] = (uint8_t)(record.value >> 8);
+        out += TraceRecorder_RecordSize;
+    }
+
+    return required;
+}
+
+// ------------------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------------------
+// Private Methods
+// ------------------------------------------------------------------------------------
+
+void TraceRecorder::Append(TraceKind kind, uint8_t id, uint16_t value)
+{
+    if (!this->_isRecording || this->_capacity == 0) { return; }
+
+    uint32_t now = millis();
+    uint32_t elapsed = now - this->_lastMillis;
+    this->_lastMillis = now;
+
+    while (elapsed > 0xFFFF)
+    {
+        Push(0xFFFF, TraceKind::TraceTimeGap, 0, 0);
+        elapsed -= 0xFFFF;
+    }
+
+    Push((uint16_t)elapsed, kind, id, value);
+}
+
+void TraceRecorder::Push(uint16_t deltaMS, TraceKind kind, uint8_t id, uint16_t value)
+{
+    TraceRecord &record = this->_buffer[this->_head];
+    record.deltaMS = deltaMS;
+    record.kind = kind;
+    record.id = id;
+    record.value = value;
+
+    this->_head = this->_head + 1 == this->_capacity ? 0 : this->_head + 1;
+
+    if (this->_count < this->_capacity)
+    {
+        this->_count++;
+    }
+    else
+    {
+        this->_dropped++;
+    }
+}
+
+// ------------------------------------------------------------------------------------
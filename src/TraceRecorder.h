@@ -0,0 +1,182 @@
+/**************************************************************************************
+ * Copyright Naigon's Electronic Creations 2021. All rights reserved.
+ **************************************************************************************/
+
+/**
+  *************************************************************************************
+  * @file    TraceRecorder.h
+  * @author  Naigon's Electronic Creations
+  * @brief   TraceRecorder
+  *          Compact binary event trace kept in a fixed RAM ring buffer. Each record is
+  *          six (6) bytes and stores the milliseconds since the previous record, so
+  *          recording costs a millis() read and a handful of stores. When the buffer
+  *          is full the oldest records are overwritten.
+  *
+  *          Button samples, callback firings and Stopwatch probe results can be
+  *          recorded. The trace is then written out with Serialize, and can be fed
+  *          back through the Button/callback logic on the host with TraceReplayer
+  *          (see extras/host).
+  *
+  *          Serialized layout, little-endian:
+  *            'C' 'G' 'T' version(1) | count(uint16) | count * record
+  *          where a record is
+  *            deltaMS(uint16) | kind(uint8) | id(uint8) | value(uint16)
+  *************************************************************************************
+**/
+
+#ifndef __TraceRecorder_H_
+#define __TraceRecorder_H_
+
+#include "Arduino.h"
+#include "Button.h"
+#include "Stopwatch.h"
+
+#define TraceRecorder_Version 1
+#define TraceRecorder_HeaderSize 6
+#define TraceRecorder_RecordSize 6
+
+// Buttons with an id below this have their pin level tracked so that only level
+// changes are recorded. Higher ids only record non-NotPressed states.
+#define TraceRecorder_TrackedButtons 32
+
+// Flag set in the value of a TraceButton record when the button was pressed.
+#define TraceRecorder_ButtonPressedFlag 0x0100
+
+enum TraceKind : uint8_t
+{
+    // Button sample. id is the Button::Id(); value is the ButtonState in the low byte
+    // with TraceRecorder_ButtonPressedFlag set if the button was pressed.
+    TraceButton = 0,
+
+    // Callback fired. id is a user-chosen source id; value is user defined.
+    TraceCallback = 1,
+
+    // Stopwatch probe. id is a user-chosen probe id; value is the elapsed micros,
+    // saturated to 65535.
+    TraceProbe = 2,
+
+    // No event; only advances time when more than 65535 ms pass between records.
+    TraceTimeGap = 3,
+};
+
+struct TraceRecord
+{
+    uint16_t deltaMS;
+    uint8_t kind;
+    uint8_t id;
+    uint16_t value;
+};
+
+class TraceRecorder
+{
+  public:
+    /**
+     * @brief   Constructs a new instance of the TraceRecorder class. The recorder is
+     *          stopped until Start is called.
+     *
+     * @param   buffer
+     *          Storage for the ring buffer. Must outlive the recorder.
+     *
+     * @param   capacity
+     *          Number of records that fit in buffer.
+     **/
+    TraceRecorder(TraceRecord *buffer, uint16_t capacity);
+
+    /**
+     * @brief   Start (or resume) recording. Time is measured from this call.
+     **/
+    void Start();
+
+    /**
+     * @brief   Stop recording. Calls to the Record methods are ignored until restarted.
+     **/
+    void Stop();
+
+    /**
+     * @brief   Discard all records.
+     **/
+    void Clear();
+
+    /**
+     * @brief   Calls DetermineButtonState on the button and records the result when
+     *          the pin level changed or the state is not NotPressed. The level recorded
+     *          is the one DetermineButtonState read. Use this in place of calling
+     *          DetermineButtonState directly.
+     *
+     * @return  The state returned by DetermineButtonState.
+     **/
+    ButtonState SampleButton(Button &button);
+
+    /**
+     * @brief   Records a button sample unconditionally.
+     **/
+    void RecordButton(uint8_t buttonId, bool isPressed, ButtonState state);
+
+    /**
+     * @brief   Records that a callback was fired.
+     *
+     * @param   sourceId
+     *          Id identifying which handler fired.
+     *
+     * @param   value
+     *          Optional data to keep with the record, ie an event id.
+     **/
+    void RecordCallback(uint8_t sourceId, uint16_t value = 0);
+
+    /**
+     * @brief   Records the elapsed micros of a Stopwatch used to time a code section.
+     **/
+    void RecordProbe(uint8_t probeId, const Stopwatch &stopwatch);
+
+    /**
+     * @brief   Number of records currently held.
+     **/
+    uint16_t Count() const;
+
+    /**
+     * @brief   Number of records that were overwritten because the buffer was full.
+     **/
+    uint32_t DroppedCount() const;
+
+    /**
+     * @brief   Get a record.
+     *
+     * @param   index
+     *          Zero (0) is the oldest record held; Count() - 1 is the newest.
+     **/
+    const TraceRecord& At(uint16_t index) const;
+
+    /**
+     * @brief   Size in bytes that Serialize needs for the current records.
+     **/
+    uint32_t SerializedSize() const;
+
+    /**
+     * @brief   Write the trace, oldest record first, in the binary layout described at
+     *          the top of this file.
+     *
+     * @param   out
+     *          Destination buffer.
+     *
+     * @param   size
+     *          Size of the destination buffer.
+     *
+     * @return  Number of bytes written, or zero (0) if the buffer is too small.
+     **/
+    uint32_t Serialize(uint8_t *out, uint32_t size) const;
+
+  private:
+    void Append(TraceKind kind, uint8_t id, uint16_t value);
+    void Push(uint16_t deltaMS, TraceKind kind, uint8_t id, uint16_t value);
+
+    TraceRecord *_buffer;
+    uint16_t _capacity;
+    uint16_t _head;
+    uint16_t _count;
+    uint32_t _dropped;
+    uint32_t _lastMillis;
+    uint32_t _buttonLevels;
+    bool _isRecording;
+};
+
+#endif //__TraceRecorder_H_